@@ -0,0 +1,347 @@
+#include <algorithm>
+#include "AlphaBetaSearch.h"
+
+namespace
+{
+	// Scores are always within +/-(WIN_SCORE_BASE - 5), so anything outside that works as infinity
+	const int INFINITE_SCORE = 100;
+
+	// Static move order: center first, then the corners, then the edges
+	// Within each group, moves with a better history score go first
+	const int MOVE_GROUPS[BoardLocation::Num_Locations] =
+	{
+		1, 2, 1,
+		2, 0, 2,
+		1, 2, 1
+	};
+}
+
+
+
+//--- Constructors and Destructor ---//
+AlphaBetaSearch::AlphaBetaSearch()
+{
+	transpositionTable = std::vector<TranspositionEntry>(NUM_BOARD_INDICES);
+	sharedTable = nullptr;
+	ClearTranspositionTable();
+
+	nodesSearched = 0;
+	tableHits = 0;
+	cutoffs = 0;
+	depthReached = 0;
+	isSearchAborted = false;
+	hitDepthLimit = false;
+}
+
+AlphaBetaSearch::~AlphaBetaSearch()
+{
+}
+
+
+
+//--- Methods ---//
+BoardLocation AlphaBetaSearch::FindBestMove(const BoardConfiguration& _layout, int* _outScore)
+{
+	// With no limits, the deepening runs until the search reaches the end of the game
+	return FindBestMove(_layout, SearchLimits(), _outScore);
+}
+
+BoardLocation AlphaBetaSearch::FindBestMove(const BoardConfiguration& _layout, SearchLimits _limits, int* _outScore)
+{
+	// Reset the stats and the budget for this search
+	nodesSearched = 0;
+	tableHits = 0;
+	cutoffs = 0;
+	depthReached = 0;
+	limits = _limits;
+	searchStartTime = std::chrono::steady_clock::now();
+	isSearchAborted = false;
+
+	// If the game is already over, there is no move to make
+	if (_layout.EvaluateWinner() != ' ')
+		return BoardLocation::Num_Locations;
+
+	// Iterative deepening: search 1 move ahead, then 2, and so on until the end of the game or the budget runs out
+	// Each iteration reuses the transposition table from the last one, so the best moves found so far are tried first
+	BoardLocation goodOptions[BoardLocation::Num_Locations];
+	int numGoodOptions = 0;
+	int bestScore = 0;
+	int numEmptySpaces = BoardLocation::Num_Locations - _layout.GetNumPlacedTiles();
+	for (int depth = 1; depth <= numEmptySpaces; depth++)
+	{
+		BoardLocation iterationOptions[BoardLocation::Num_Locations];
+		int numIterationOptions = 0;
+		hitDepthLimit = false;
+		int iterationScore = SearchRoot(_layout, depth, iterationOptions, numIterationOptions);
+
+		// An iteration that ran out of budget partway through is thrown away, the last finished one is used instead
+		// The budget isn't checked until the first iteration finishes, so there is always a move to return
+		if (isSearchAborted)
+			break;
+
+		std::copy(iterationOptions, iterationOptions + numIterationOptions, goodOptions);
+		numGoodOptions = numIterationOptions;
+		bestScore = iterationScore;
+		depthReached = depth;
+
+		// If no layout was cut off by the depth limit, the search already reached the end of the game and going deeper won't change anything
+		if (!hitDepthLimit || IsOutOfBudget())
+			break;
+	}
+
+	if (_outScore != nullptr)
+		*_outScore = bestScore;
+
+	// Randomly select one of the equally good moves
+	return goodOptions[randomEngine() % numGoodOptions];
+}
+
+void AlphaBetaSearch::ClearTranspositionTable()
+{
+	// Forget every stored score and the move history. A shared table is left alone since other searches might still be using it
+	TranspositionEntry emptyEntry = { 0, Bound_None, BoardLocation::Num_Locations, 0 };
+	std::fill(transpositionTable.begin(), transpositionTable.end(), emptyEntry);
+
+	for (int i = 0; i < BoardLocation::Num_Locations; i++)
+		historyScores[i] = 0;
+}
+
+
+
+//--- Setters and Getters ---//
+int AlphaBetaSearch::GetNodesSearched() const {
+	return nodesSearched;
+}
+
+int AlphaBetaSearch::GetTableHits() const {
+	return tableHits;
+}
+
+int AlphaBetaSearch::GetCutoffs() const {
+	return cutoffs;
+}
+
+int AlphaBetaSearch::GetDepthReached() const {
+	return depthReached;
+}
+
+void AlphaBetaSearch::SetSeed(uint32_t _seed) {
+	randomEngine.seed(_seed);
+}
+
+void AlphaBetaSearch::SetSharedTable(TranspositionTable* _sharedTable) {
+	sharedTable = _sharedTable;
+}
+
+
+
+//--- Utility Functions ---//
+int AlphaBetaSearch::SearchRoot(const BoardConfiguration& _layout, int _depth, BoardLocation* _outGoodOptions, int& _outNumGoodOptions)
+{
+	char tileToMove = _layout.GetTileToMove();
+	char nextTileToMove = (tileToMove == 'X') ? 'O' : 'X';
+
+	// Order the root moves the same way as everywhere else, starting with the best move from the last iteration
+	TranspositionEntry entry = LoadEntry(_layout);
+	BoardLocation firstMove = (entry.bound != Bound_None) ? BoardLocation(entry.bestMove) : BoardLocation::Num_Locations;
+	BoardLocation moves[BoardLocation::Num_Locations];
+	int numMoves = OrderMoves(_layout, firstMove, moves);
+
+	// Search every root move with the window just below the best score so far. Anything that scores above alpha is exact,
+	// which means every move that ties for the best score can be found and the AI can pick randomly between them like the tree does
+	int bestScore = -INFINITE_SCORE;
+	_outNumGoodOptions = 0;
+	for (int i = 0; i < numMoves; i++)
+	{
+		BoardConfiguration childLayout = _layout;
+		childLayout.ApplyMove(moves[i], tileToMove);
+		int score = -Negamax(childLayout, nextTileToMove, _depth - 1, -INFINITE_SCORE, -(bestScore - 1));
+
+		// Stop as soon as the budget is gone
+		if (isSearchAborted)
+			break;
+
+		if (score > bestScore)
+		{
+			bestScore = score;
+			_outNumGoodOptions = 0;
+		}
+
+		if (score == bestScore)
+			_outGoodOptions[_outNumGoodOptions++] = moves[i];
+	}
+
+	// Remember the result and the best move so the next iteration tries it first
+	// The root window has no upper limit, so it can't fail high and the score is exact. It is stored as deep as it was searched, the same as in Negamax,
+	// but not over an entry that was searched deeper already, ex: by an earlier move's search that reached the end of the game
+	int searchDepth = (_depth >= numMoves) ? int(BoardLocation::Num_Locations) : _depth;
+	if (_outNumGoodOptions > 0 && !isSearchAborted && (entry.bound == Bound_None || entry.depth <= searchDepth))
+	{
+		TranspositionEntry rootEntry = { int8_t(bestScore), Bound_Exact, uint8_t(_outGoodOptions[0]), uint8_t(searchDepth) };
+		StoreEntry(_layout, rootEntry);
+	}
+
+	return bestScore;
+}
+
+int AlphaBetaSearch::Negamax(const BoardConfiguration& _layout, char _tileToMove, int _depth, int _alpha, int _beta)
+{
+	nodesSearched++;
+
+	// Stop searching once the budget has run out. Whatever is returned from here is thrown away by FindBestMove
+	// The clock is only checked every so often since reading it is much slower than searching a node
+	if (depthReached > 0 && ((limits.maxNodes > 0 && nodesSearched >= limits.maxNodes) || (nodesSearched % 64 == 0 && IsOutOfBudget())))
+	{
+		isSearchAborted = true;
+		return 0;
+	}
+
+	// If the last move ended the game, it was a win for whoever made it (so a loss from this side's perspective) or a tie
+	// Losses that take longer to arrive score less badly, so the losing side drags the game out and the winning side finishes it quickly
+	char winner = _layout.EvaluateWinner();
+	if (winner != ' ')
+		return (winner == '-') ? 0 : -(WIN_SCORE_BASE - _layout.GetNumPlacedTiles());
+
+	// Past the depth limit, the result isn't known yet so it is scored as neutral
+	if (_depth <= 0)
+	{
+		hitDepthLimit = true;
+		return 0;
+	}
+
+	// Collect the moves first since the number of them determines if this search can reach the end of the game
+	TranspositionEntry entry = LoadEntry(_layout);
+	BoardLocation firstMove = (entry.bound != Bound_None) ? BoardLocation(entry.bestMove) : BoardLocation::Num_Locations;
+	BoardLocation moves[BoardLocation::Num_Locations];
+	int numMoves = OrderMoves(_layout, firstMove, moves);
+
+	// A search at least as deep as the number of empty spaces reaches the end of the game, so it is stored as complete
+	int searchDepth = (_depth >= numMoves) ? int(BoardLocation::Num_Locations) : _depth;
+
+	// Check if this layout has already been searched deeply enough with a result that is good enough to use here
+	if (entry.bound != Bound_None && entry.depth >= searchDepth)
+	{
+		if (entry.bound == Bound_Exact || (entry.bound == Bound_Lower && entry.score >= _beta) || (entry.bound == Bound_Upper && entry.score <= _alpha))
+		{
+			// A stored score that didn't reach the end of the game was cut off by a depth limit too, so the next iteration still needs to go deeper
+			tableHits++;
+			if (entry.depth < BoardLocation::Num_Locations)
+				hitDepthLimit = true;
+
+			return entry.score;
+		}
+	}
+
+	int originalAlpha = _alpha;
+	char nextTileToMove = (_tileToMove == 'X') ? 'O' : 'X';
+
+	// Search the moves in order, trying the best move from an earlier search first
+	int bestScore = -INFINITE_SCORE;
+	BoardLocation bestMove = moves[0];
+	for (int i = 0; i < numMoves; i++)
+	{
+		BoardConfiguration childLayout = _layout;
+		childLayout.ApplyMove(moves[i], _tileToMove);
+		int score = -Negamax(childLayout, nextTileToMove, _depth - 1, -_beta, -_alpha);
+
+		// Don't store anything from a search that was cut short, since the scores it returned are meaningless
+		if (isSearchAborted)
+			return 0;
+
+		if (score > bestScore)
+		{
+			bestScore = score;
+			bestMove = moves[i];
+		}
+
+		_alpha = std::max(_alpha, score);
+
+		// The opponent would never allow this line, so the rest of the moves don't matter
+		if (_alpha >= _beta)
+		{
+			cutoffs++;
+			historyScores[moves[i]] += _depth * _depth;
+			break;
+		}
+	}
+
+	// Store the result along with what kind of bound it is and how deep it was searched
+	entry.score = int8_t(bestScore);
+	entry.bestMove = uint8_t(bestMove);
+	entry.bound = (bestScore <= originalAlpha) ? Bound_Upper : (bestScore >= _beta) ? Bound_Lower : Bound_Exact;
+	entry.depth = uint8_t(searchDepth);
+	StoreEntry(_layout, entry);
+
+	return bestScore;
+}
+
+bool AlphaBetaSearch::IsOutOfBudget() const
+{
+	// Check if either the node budget or the time budget has been used up
+	if (limits.maxNodes > 0 && nodesSearched >= limits.maxNodes)
+		return true;
+
+	if (limits.maxSeconds > 0.0)
+	{
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - searchStartTime;
+		return elapsed.count() >= limits.maxSeconds;
+	}
+
+	return false;
+}
+
+TranspositionEntry AlphaBetaSearch::LoadEntry(const BoardConfiguration& _layout) const
+{
+	// A miss in the shared table looks the same as an empty entry in the local one
+	if (sharedTable == nullptr)
+		return transpositionTable[_layout.GetIndex()];
+
+	TranspositionEntry entry = { 0, Bound_None, BoardLocation::Num_Locations, 0 };
+	sharedTable->Probe(_layout.GetHash(), entry);
+	return entry;
+}
+
+void AlphaBetaSearch::StoreEntry(const BoardConfiguration& _layout, const TranspositionEntry& _entry)
+{
+	if (sharedTable == nullptr)
+		transpositionTable[_layout.GetIndex()] = _entry;
+	else
+		sharedTable->Store(_layout.GetHash(), _entry);
+}
+
+int AlphaBetaSearch::OrderMoves(const BoardConfiguration& _layout, BoardLocation _firstMove, BoardLocation* _outMoves) const
+{
+	// Collect the empty spaces
+	BoardMask occupiedTiles = _layout.xTiles | _layout.oTiles;
+	int numMoves = 0;
+	for (int i = 0; i < BoardLocation::Num_Locations; i++)
+	{
+		if (!(occupiedTiles & (1 << i)))
+			_outMoves[numMoves++] = BoardLocation(i);
+	}
+
+	// Sort them so the first move goes first, then by group (center, corners, edges), then by history
+	// Insertion sort since there are never more than 9 moves
+	for (int i = 1; i < numMoves; i++)
+	{
+		BoardLocation move = _outMoves[i];
+		int j = i - 1;
+
+		while (j >= 0)
+		{
+			BoardLocation other = _outMoves[j];
+			bool goesFirst = (move == _firstMove) ||
+				(other != _firstMove && (MOVE_GROUPS[move] < MOVE_GROUPS[other] || (MOVE_GROUPS[move] == MOVE_GROUPS[other] && historyScores[move] > historyScores[other])));
+
+			if (!goesFirst)
+				break;
+
+			_outMoves[j + 1] = other;
+			j--;
+		}
+
+		_outMoves[j + 1] = move;
+	}
+
+	return numMoves;
+}
\ No newline at end of file
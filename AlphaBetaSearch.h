@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "BoardConfiguration.h"
+#include "TranspositionTable.h"
+
+// Limits on how much work a single move is allowed to take. Zero means no limit
+struct SearchLimits
+{
+	double maxSeconds = 0.0;
+	int maxNodes = 0;
+};
+
+// Searches for the best move on demand with negamax alpha-beta instead of building the whole tree
+// Scores inside the search are from the perspective of whoever is moving: wins are positive, losses are negative and ties are 0
+// Like the other score sources, a win is worth WIN_SCORE_BASE minus the number of tiles on the board when it happens
+// Layouts past the depth limit of an iteration are scored as 0 since their result isn't known yet
+class AlphaBetaSearch
+{
+public:
+	//--- Constructors and Destructor ---//
+	AlphaBetaSearch();
+	~AlphaBetaSearch();
+
+	//--- Methods ---//
+	BoardLocation FindBestMove(const BoardConfiguration& _layout, int* _outScore = nullptr);
+	BoardLocation FindBestMove(const BoardConfiguration& _layout, SearchLimits _limits, int* _outScore = nullptr);
+	void ClearTranspositionTable();
+
+	//--- Setters and Getters ---//
+	int GetNodesSearched() const;
+	int GetTableHits() const;
+	int GetCutoffs() const;
+	int GetDepthReached() const;
+	void SetSeed(uint32_t _seed);
+	void SetSharedTable(TranspositionTable* _sharedTable);
+
+private:
+	//--- Data ---//
+	// One entry per layout, indexed the same way as PositionTable
+	std::vector<TranspositionEntry> transpositionTable;
+
+	// If set, this is used instead of transpositionTable so several searches on different threads can share what they find
+	TranspositionTable* sharedTable;
+
+	// How often each move has caused a cutoff, used to order moves that are otherwise equal
+	int historyScores[BoardLocation::Num_Locations];
+
+	// Stats about the last call to FindBestMove
+	int nodesSearched;
+	int tableHits;
+	int cutoffs;
+	int depthReached;
+
+	// The limits of the current search, and whether they have been hit
+	SearchLimits limits;
+	std::chrono::steady_clock::time_point searchStartTime;
+	bool isSearchAborted;
+	bool hitDepthLimit;
+
+	// Picks between equally good moves. Each search has its own so searches on different threads don't share any state
+	std::minstd_rand randomEngine;
+
+	//--- Utility Functions ---//
+	int SearchRoot(const BoardConfiguration& _layout, int _depth, BoardLocation* _outGoodOptions, int& _outNumGoodOptions);
+	int Negamax(const BoardConfiguration& _layout, char _tileToMove, int _depth, int _alpha, int _beta);
+	bool IsOutOfBudget() const;
+	TranspositionEntry LoadEntry(const BoardConfiguration& _layout) const;
+	void StoreEntry(const BoardConfiguration& _layout, const TranspositionEntry& _entry);
+	int OrderMoves(const BoardConfiguration& _layout, BoardLocation _firstMove, BoardLocation* _outMoves) const;
+};
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include <cstring>
+#include "BatchClassifier.h"
+
+// The vector paths are only available on x86. Everywhere else, every path falls back to the scalar one
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BATCH_CLASSIFIER_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#else
+#define BATCH_CLASSIFIER_X86 0
+#endif
+
+// GCC and Clang need to be told a function is allowed to use AVX2 since the rest of the program isn't compiled for it
+// MSVC allows the intrinsics anywhere, so nothing is needed there
+#if BATCH_CLASSIFIER_X86 && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+namespace
+{
+	// The 8 possible win states as bitmasks, same as in BoardConfiguration.cpp
+	const BoardMask WIN_LINES[8] =
+	{
+		0x007, 0x038, 0x1C0,	// Rows
+		0x049, 0x092, 0x124,	// Cols
+		0x111, 0x054			// Diagonals
+	};
+
+	// Which path Classifier_Best resolves to. Worked out once, the first time it is needed
+	ClassifierPath DetectBestPath()
+	{
+#if BATCH_CLASSIFIER_X86
+#ifdef _MSC_VER
+		// AVX2 needs both the CPU flag and the OS saving the wider registers (OSXSAVE + XCR0)
+		int cpuInfo[4];
+		__cpuid(cpuInfo, 0);
+		if (cpuInfo[0] >= 7)
+		{
+			__cpuid(cpuInfo, 1);
+			bool hasOSXSave = (cpuInfo[2] & (1 << 27)) != 0 && (cpuInfo[2] & (1 << 28)) != 0;
+			__cpuidex(cpuInfo, 7, 0);
+			if (hasOSXSave && (cpuInfo[1] & (1 << 5)) != 0 && (_xgetbv(0) & 0x6) == 0x6)
+				return Classifier_AVX2;
+		}
+#else
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2"))
+			return Classifier_AVX2;
+#endif
+		// Every x86-64 CPU has SSE2
+		return Classifier_SSE2;
+#else
+		return Classifier_Scalar;
+#endif
+	}
+}
+
+
+
+//--- Static Methods ---//
+void BatchClassifier::ClassifyBoards(const PackedBoard* _boards, char* _outResults, size_t _numBoards, ClassifierPath _path)
+{
+	if (_path == Classifier_Best)
+		_path = GetBestPath();
+
+	// A path the CPU can't run falls back to the next best one
+	if (_path == Classifier_AVX2 && GetBestPath() != Classifier_AVX2)
+		_path = Classifier_SSE2;
+	if (_path == Classifier_SSE2 && GetBestPath() == Classifier_Scalar)
+		_path = Classifier_Scalar;
+
+	if (_path == Classifier_AVX2)
+		ClassifyAVX2(_boards, _outResults, _numBoards);
+	else if (_path == Classifier_SSE2)
+		ClassifySSE2(_boards, _outResults, _numBoards);
+	else
+		ClassifyScalar(_boards, _outResults, _numBoards);
+}
+
+ClassifierPath BatchClassifier::GetBestPath()
+{
+	static const ClassifierPath bestPath = DetectBestPath();
+	return bestPath;
+}
+
+const char* BatchClassifier::GetPathName(ClassifierPath _path)
+{
+	switch (_path)
+	{
+	case Classifier_Scalar:
+		return "Scalar";
+	case Classifier_SSE2:
+		return "SSE2";
+	case Classifier_AVX2:
+		return "AVX2";
+	default:
+		return GetPathName(GetBestPath());
+	}
+}
+
+PackedBoard BatchClassifier::Pack(const BoardConfiguration& _layout)
+{
+	return PackedBoard(_layout.xTiles) | (PackedBoard(_layout.oTiles) << 16);
+}
+
+BoardConfiguration BatchClassifier::Unpack(PackedBoard _board)
+{
+	BoardConfiguration layout;
+	layout.SetTiles(BoardMask(_board & 0xFFFF), BoardMask(_board >> 16));
+	return layout;
+}
+
+
+
+//--- Utility Functions ---//
+void BatchClassifier::ClassifyScalar(const PackedBoard* _boards, char* _outResults, size_t _numBoards)
+{
+	// One board at a time with the win table lookup, same order of checks as BoardConfiguration::SetTiles()
+	for (size_t i = 0; i < _numBoards; i++)
+	{
+		BoardMask xTiles = BoardMask(_boards[i] & FULL_BOARD_MASK);
+		BoardMask oTiles = BoardMask((_boards[i] >> 16) & FULL_BOARD_MASK);
+
+		if (BoardConfiguration::IsWinningMask(xTiles))
+			_outResults[i] = 'X';
+		else if (BoardConfiguration::IsWinningMask(oTiles))
+			_outResults[i] = 'O';
+		else
+			_outResults[i] = ((xTiles | oTiles) == FULL_BOARD_MASK) ? '-' : ' ';
+	}
+}
+
+void BatchClassifier::ClassifySSE2(const PackedBoard* _boards, char* _outResults, size_t _numBoards)
+{
+#if BATCH_CLASSIFIER_X86
+	const __m128i boardMask = _mm_set1_epi32(FULL_BOARD_MASK);
+	const __m128i inProgressResult = _mm_set1_epi32(' ');
+	const __m128i tieResult = _mm_set1_epi32('-');
+	const __m128i xWinResult = _mm_set1_epi32('X');
+	const __m128i oWinResult = _mm_set1_epi32('O');
+
+	// 4 boards per iteration, one per 32 bit lane
+	size_t i = 0;
+	for (; i + 4 <= _numBoards; i += 4)
+	{
+		__m128i boards = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_boards + i));
+		__m128i xTiles = _mm_and_si128(boards, boardMask);
+		__m128i oTiles = _mm_and_si128(_mm_srli_epi32(boards, 16), boardMask);
+
+		// A lane is all ones if that player's tiles cover the whole line
+		__m128i xWins = _mm_setzero_si128();
+		__m128i oWins = _mm_setzero_si128();
+		for (int line = 0; line < 8; line++)
+		{
+			__m128i lineMask = _mm_set1_epi32(WIN_LINES[line]);
+			xWins = _mm_or_si128(xWins, _mm_cmpeq_epi32(_mm_and_si128(xTiles, lineMask), lineMask));
+			oWins = _mm_or_si128(oWins, _mm_cmpeq_epi32(_mm_and_si128(oTiles, lineMask), lineMask));
+		}
+		__m128i isFull = _mm_cmpeq_epi32(_mm_or_si128(xTiles, oTiles), boardMask);
+
+		// Pick the result for each lane, with the later checks taking priority: in progress < tie < O wins < X wins
+		__m128i results = inProgressResult;
+		results = _mm_or_si128(_mm_andnot_si128(isFull, results), _mm_and_si128(isFull, tieResult));
+		results = _mm_or_si128(_mm_andnot_si128(oWins, results), _mm_and_si128(oWins, oWinResult));
+		results = _mm_or_si128(_mm_andnot_si128(xWins, results), _mm_and_si128(xWins, xWinResult));
+
+		// Narrow the 4 results down to 4 bytes and store them together. x86 is little endian, so lane 0 is the first byte
+		results = _mm_packs_epi32(results, results);
+		results = _mm_packus_epi16(results, results);
+		int packedResults = _mm_cvtsi128_si32(results);
+		std::memcpy(_outResults + i, &packedResults, 4);
+	}
+
+	// Finish off the last few boards one at a time
+	ClassifyScalar(_boards + i, _outResults + i, _numBoards - i);
+#else
+	ClassifyScalar(_boards, _outResults, _numBoards);
+#endif
+}
+
+TARGET_AVX2 void BatchClassifier::ClassifyAVX2(const PackedBoard* _boards, char* _outResults, size_t _numBoards)
+{
+#if BATCH_CLASSIFIER_X86
+	const __m256i boardMask = _mm256_set1_epi32(FULL_BOARD_MASK);
+	const __m256i inProgressResult = _mm256_set1_epi32(' ');
+	const __m256i tieResult = _mm256_set1_epi32('-');
+	const __m256i xWinResult = _mm256_set1_epi32('X');
+	const __m256i oWinResult = _mm256_set1_epi32('O');
+
+	// 8 boards per iteration, one per 32 bit lane
+	size_t i = 0;
+	for (; i + 8 <= _numBoards; i += 8)
+	{
+		__m256i boards = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_boards + i));
+		__m256i xTiles = _mm256_and_si256(boards, boardMask);
+		__m256i oTiles = _mm256_and_si256(_mm256_srli_epi32(boards, 16), boardMask);
+
+		// A lane is all ones if that player's tiles cover the whole line
+		__m256i xWins = _mm256_setzero_si256();
+		__m256i oWins = _mm256_setzero_si256();
+		for (int line = 0; line < 8; line++)
+		{
+			__m256i lineMask = _mm256_set1_epi32(WIN_LINES[line]);
+			xWins = _mm256_or_si256(xWins, _mm256_cmpeq_epi32(_mm256_and_si256(xTiles, lineMask), lineMask));
+			oWins = _mm256_or_si256(oWins, _mm256_cmpeq_epi32(_mm256_and_si256(oTiles, lineMask), lineMask));
+		}
+		__m256i isFull = _mm256_cmpeq_epi32(_mm256_or_si256(xTiles, oTiles), boardMask);
+
+		// Pick the result for each lane, with the later checks taking priority: in progress < tie < O wins < X wins
+		__m256i results = inProgressResult;
+		results = _mm256_blendv_epi8(results, tieResult, isFull);
+		results = _mm256_blendv_epi8(results, oWinResult, oWins);
+		results = _mm256_blendv_epi8(results, xWinResult, xWins);
+
+		// Narrow the 8 results down to bytes. Packing works within each 128 bit half, so each half ends up with 4 of the results
+		results = _mm256_packs_epi32(results, results);
+		results = _mm256_packus_epi16(results, results);
+		int lowResults = _mm_cvtsi128_si32(_mm256_castsi256_si128(results));
+		int highResults = _mm_cvtsi128_si32(_mm256_extracti128_si256(results, 1));
+		std::memcpy(_outResults + i, &lowResults, 4);
+		std::memcpy(_outResults + i + 4, &highResults, 4);
+	}
+
+	// Finish off the last few boards one at a time
+	ClassifyScalar(_boards + i, _outResults + i, _numBoards - i);
+#else
+	ClassifyScalar(_boards, _outResults, _numBoards);
+#endif
+}
\ No newline at end of file
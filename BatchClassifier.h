@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BoardConfiguration.h"
+
+// A board packed into 32 bits for bulk processing: xTiles in the low 16 bits and oTiles in the high 16 bits
+typedef uint32_t PackedBoard;
+
+// The instruction sets ClassifyBoards can use. Classifier_Best picks the fastest one the CPU supports when the program runs
+enum ClassifierPath
+{
+	Classifier_Best,
+	Classifier_Scalar,
+	Classifier_SSE2,
+	Classifier_AVX2
+};
+
+// Classifies large arrays of boards as won by X, won by O, tied or still in progress
+// The vector paths test all 8 win lines against 4 (SSE2) or 8 (AVX2) boards at once
+// The results use the same characters as BoardConfiguration::EvaluateWinner(): 'X', 'O', '-' for a tie and a space if the game is still going
+class BatchClassifier
+{
+public:
+	//--- Static Methods ---//
+	static void ClassifyBoards(const PackedBoard* _boards, char* _outResults, size_t _numBoards, ClassifierPath _path = Classifier_Best);
+	static ClassifierPath GetBestPath();
+	static const char* GetPathName(ClassifierPath _path);
+	static PackedBoard Pack(const BoardConfiguration& _layout);
+	static BoardConfiguration Unpack(PackedBoard _board);
+
+private:
+	//--- Utility Functions ---//
+	static void ClassifyScalar(const PackedBoard* _boards, char* _outResults, size_t _numBoards);
+	static void ClassifySSE2(const PackedBoard* _boards, char* _outResults, size_t _numBoards);
+	static void ClassifyAVX2(const PackedBoard* _boards, char* _outResults, size_t _numBoards);
+};
\ No newline at end of file
@@ -1,60 +1,386 @@
+#include <array>
 #include "BoardConfiguration.h"
 
+//--- Win Table ---//
+namespace
+{
+	// The 8 possible win states as bitmasks (matched row x3, matched col x3, diagonal x2)
+	const BoardMask WIN_LINES[8] =
+	{
+		0x007, 0x038, 0x1C0,	// Rows
+		0x049, 0x092, 0x124,	// Cols
+		0x111, 0x054			// Diagonals
+	};
+
+	// Precompute, for every one of the 512 possible single-player masks, whether it contains a full line
+	// This turns the win check into a single load instead of a chain of comparisons
+	std::array<bool, 512> BuildWinTable()
+	{
+		std::array<bool, 512> table = std::array<bool, 512>();
+
+		for (int mask = 0; mask < 512; mask++)
+		{
+			table[mask] = false;
+
+			for (int line = 0; line < 8; line++)
+			{
+				if ((mask & WIN_LINES[line]) == WIN_LINES[line])
+					table[mask] = true;
+			}
+		}
+
+		return table;
+	}
+
+	const std::array<bool, 512> WIN_TABLE = BuildWinTable();
+
+	// Precompute the base-3 value of every single-player mask (sum of 3^location for each set bit)
+	// The full index is then BASE3_TABLE[xTiles] + 2 * BASE3_TABLE[oTiles]
+	std::array<uint16_t, 512> BuildBase3Table()
+	{
+		std::array<uint16_t, 512> table = std::array<uint16_t, 512>();
+
+		for (int mask = 0; mask < 512; mask++)
+		{
+			int value = 0;
+			int placeValue = 1;
+
+			for (int i = 0; i < BoardLocation::Num_Locations; i++)
+			{
+				if (mask & (1 << i))
+					value += placeValue;
+
+				placeValue *= 3;
+			}
+
+			table[mask] = uint16_t(value);
+		}
+
+		return table;
+	}
+
+	const std::array<uint16_t, 512> BASE3_TABLE = BuildBase3Table();
+
+	// The win lines that pass through each location. The center is on 4 of them, the corners on 3 and the edges on 2
+	struct LinesThroughLocation
+	{
+		BoardMask lines[4];
+		int numLines;
+	};
+
+	std::array<LinesThroughLocation, BoardLocation::Num_Locations> BuildLinesThroughTable()
+	{
+		std::array<LinesThroughLocation, BoardLocation::Num_Locations> table = std::array<LinesThroughLocation, BoardLocation::Num_Locations>();
+
+		for (int i = 0; i < BoardLocation::Num_Locations; i++)
+		{
+			table[i].numLines = 0;
+
+			for (int line = 0; line < 8; line++)
+			{
+				if (WIN_LINES[line] & (1 << i))
+					table[i].lines[table[i].numLines++] = WIN_LINES[line];
+			}
+		}
+
+		return table;
+	}
+
+	const std::array<LinesThroughLocation, BoardLocation::Num_Locations> LINES_THROUGH_TABLE = BuildLinesThroughTable();
+}
+
+
+
+//--- Symmetry Tables ---//
+namespace
+{
+	// Where each location ends up under each of the 8 symmetries
+	// Order is: identity, rotate 90 clockwise, rotate 180, rotate 270 clockwise, mirror left-right, mirror top-bottom, main diagonal, anti diagonal
+	const int SYMMETRY_MAPS[NUM_BOARD_SYMMETRIES][BoardLocation::Num_Locations] =
+	{
+		{ 0, 1, 2, 3, 4, 5, 6, 7, 8 },
+		{ 2, 5, 8, 1, 4, 7, 0, 3, 6 },
+		{ 8, 7, 6, 5, 4, 3, 2, 1, 0 },
+		{ 6, 3, 0, 7, 4, 1, 8, 5, 2 },
+		{ 2, 1, 0, 5, 4, 3, 8, 7, 6 },
+		{ 6, 7, 8, 3, 4, 5, 0, 1, 2 },
+		{ 0, 3, 6, 1, 4, 7, 2, 5, 8 },
+		{ 8, 5, 2, 7, 4, 1, 6, 3, 0 }
+	};
+
+	// Precompute the transformed version of every single-player mask under every symmetry so transforming a board is two loads
+	std::array<std::array<BoardMask, 512>, NUM_BOARD_SYMMETRIES> BuildSymmetryTable()
+	{
+		std::array<std::array<BoardMask, 512>, NUM_BOARD_SYMMETRIES> table = std::array<std::array<BoardMask, 512>, NUM_BOARD_SYMMETRIES>();
+
+		for (int symmetry = 0; symmetry < NUM_BOARD_SYMMETRIES; symmetry++)
+		{
+			for (int mask = 0; mask < 512; mask++)
+			{
+				BoardMask transformed = 0;
+
+				for (int i = 0; i < BoardLocation::Num_Locations; i++)
+				{
+					if (mask & (1 << i))
+						transformed |= BoardMask(1 << SYMMETRY_MAPS[symmetry][i]);
+				}
+
+				table[symmetry][mask] = transformed;
+			}
+		}
+
+		return table;
+	}
+
+	const std::array<std::array<BoardMask, 512>, NUM_BOARD_SYMMETRIES> SYMMETRY_TABLE = BuildSymmetryTable();
+}
+
+
+
 //--- Methods ---//
 void BoardConfiguration::Init()
 {
 	// Set all of the spaces to neutral by default
-	/*for (int i = 0; i < BoardLocation::Num_Locations; i++)
-		placedTiles[i] = '-';*/
-	placedTiles = "---------";
-}
-
-char BoardConfiguration::EvaluateWinner()
-{
-	// Check each of the 8 possible win states (matched row x3, matched col x3, diagonal x2)
-	// Order below is: top row, middle row, bottom row, left col, middle col, right col, top left -> bottom right diagonal, top right -> bottom left diagonal
-	// Basically checking if they all match AND they're not all neutral (they match if they're neutral so need to check this too)
-	// Rows
-	if (placedTiles[Top_Left] != '-' && placedTiles[Top_Left] == placedTiles[Top_Middle] && placedTiles[Top_Left] == placedTiles[Top_Right])
-		return placedTiles[Top_Left];
-	else if (placedTiles[Center_Left] != '-' && placedTiles[Center_Left] == placedTiles[Center_Middle] && placedTiles[Center_Left] == placedTiles[Center_Right])
-		return placedTiles[Center_Left];
-	else if (placedTiles[Bottom_Left] != '-' && placedTiles[Bottom_Left] == placedTiles[Bottom_Middle] && placedTiles[Bottom_Left] == placedTiles[Bottom_Right])
-		return placedTiles[Bottom_Left];
-
-	// Cols
-	else if (placedTiles[Top_Left] != '-' && placedTiles[Top_Left] == placedTiles[Center_Left] && placedTiles[Top_Left] == placedTiles[Bottom_Left])
-		return placedTiles[Top_Left];
-	else if (placedTiles[Top_Middle] != '-' && placedTiles[Top_Middle] == placedTiles[Center_Middle] && placedTiles[Top_Middle] == placedTiles[Bottom_Middle])
-		return placedTiles[Top_Middle];
-	else if (placedTiles[Top_Right] != '-' && placedTiles[Top_Right] == placedTiles[Center_Right] && placedTiles[Top_Right] == placedTiles[Bottom_Right])
-		return placedTiles[Top_Right];
-
-	// Diagonals
-	else if (placedTiles[Top_Left] != '-' && placedTiles[Top_Left] == placedTiles[Center_Middle] && placedTiles[Top_Left] == placedTiles[Bottom_Right])
-		return placedTiles[Top_Left];
-	else if (placedTiles[Top_Right] != '-' && placedTiles[Top_Right] == placedTiles[Center_Middle] && placedTiles[Top_Right] == placedTiles[Bottom_Left])
-		return placedTiles[Top_Right];
-
-
-	// If none of the win states triggered, we should show a tie message instead
-	// Loop through all of the tiles and check if every single one is filled. If it is, show the tie message
+	xTiles = 0;
+	oTiles = 0;
+	numMoves = 0;
+	gameState = ' ';
+}
+
+char BoardConfiguration::EvaluateWinner() const
+{
+	// The result is updated whenever a tile is placed, so there is nothing to check here
+	// 'X' or 'O' if that player has won, '-' if the game is a tie, or a space if the game is still going
+	return gameState;
+}
+
+char BoardConfiguration::ApplyMove(BoardLocation _location, char _tile)
+{
+	// Place the tile. The location has to be empty and the game can't be over yet
+	BoardMask& playerTiles = (_tile == 'X') ? xTiles : oTiles;
+	playerTiles |= BoardMask(1 << _location);
+	numMoves++;
+
+	// Only the lines through the new tile could have been completed by it
+	const LinesThroughLocation& linesThrough = LINES_THROUGH_TABLE[_location];
+	for (int i = 0; i < linesThrough.numLines; i++)
+	{
+		if ((playerTiles & linesThrough.lines[i]) == linesThrough.lines[i])
+		{
+			gameState = _tile;
+			return gameState;
+		}
+	}
+
+	// If nobody won, the game is a tie once every tile has been placed
+	gameState = (numMoves == BoardLocation::Num_Locations) ? '-' : ' ';
+	return gameState;
+}
+
+char BoardConfiguration::GetTile(BoardLocation _location) const
+{
+	// Convert the bitboards back into the 'X', 'O', or '-' representation
+	BoardMask bit = BoardMask(1 << _location);
+	return (xTiles & bit) ? 'X' : (oTiles & bit) ? 'O' : '-';
+}
+
+void BoardConfiguration::SetTile(BoardLocation _location, char _tile)
+{
+	// Clear the location first and then place the new tile into the matching bitboard
+	BoardMask bit = BoardMask(1 << _location);
+	xTiles &= ~bit;
+	oTiles &= ~bit;
+
+	if (_tile == 'X')
+		xTiles |= bit;
+	else if (_tile == 'O')
+		oTiles |= bit;
+
+	// The tile could have been overwritten or cleared, so the move count and result are worked out again from scratch
+	SetTiles(xTiles, oTiles);
+}
+
+void BoardConfiguration::SetTiles(BoardMask _xTiles, BoardMask _oTiles)
+{
+	// Store both bitboards at once, ex: when reading a layout back out of a snapshot
+	xTiles = _xTiles;
+	oTiles = _oTiles;
+
+	// Count the bits that are set in either bitboard
+	BoardMask occupiedTiles = xTiles | oTiles;
+	numMoves = 0;
 	for (int i = 0; i < BoardLocation::Num_Locations; i++)
+		numMoves += (occupiedTiles >> i) & 1;
+
+	// Check if either player's tiles contain one of the 8 win states
+	// If none of the win states triggered, the game is either still going (space) or a tie if every tile is filled ('-')
+	if (WIN_TABLE[xTiles])
+		gameState = 'X';
+	else if (WIN_TABLE[oTiles])
+		gameState = 'O';
+	else
+		gameState = (occupiedTiles == FULL_BOARD_MASK) ? '-' : ' ';
+}
+
+std::string BoardConfiguration::GetPlacedTiles() const
+{
+	// Build the old string representation, ex: "X-O------"
+	std::string placedTiles = "---------";
+
+	for (int i = 0; i < BoardLocation::Num_Locations; i++)
+		placedTiles[i] = GetTile(BoardLocation(i));
+
+	return placedTiles;
+}
+
+int BoardConfiguration::GetIndex() const
+{
+	return GetIndex(xTiles, oTiles);
+}
+
+uint64_t BoardConfiguration::GetHash() const
+{
+	// Spreads both bitboards over 64 bits (the splitmix64 finalizer), so layouts that differ by one tile land far apart in a hash table
+	// The constant is added first so the empty board doesn't hash to 0
+	uint64_t hash = (uint64_t(xTiles) | (uint64_t(oTiles) << 16)) + 0x9E3779B97F4A7C15ull;
+	hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+	hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+	return hash ^ (hash >> 31);
+}
+
+int BoardConfiguration::GetNumPlacedTiles() const
+{
+	// The count is kept up to date as tiles are placed
+	return numMoves;
+}
+
+int BoardConfiguration::GetTerminalScore() const
+{
+	// Scores a finished game from X's perspective. Games that aren't over yet (and ties) are worth 0
+	int winScore = WIN_SCORE_BASE - numMoves;
+	return (gameState == 'X') ? winScore : (gameState == 'O') ? -winScore : 0;
+}
+
+char BoardConfiguration::GetTileToMove() const
+{
+	// X always goes first, so it is X's turn whenever both players have placed the same number of tiles
+	return (GetNumPlacedTiles() % 2 == 0) ? 'X' : 'O';
+}
+
+MoveList BoardConfiguration::GetEmptySpaces() const
+{
+	// Any location that is set in neither bitboard is empty
+	MoveList emptySpaces = MoveList();
+	BoardMask occupiedTiles = xTiles | oTiles;
+	for (int i = 0; i < BoardLocation::Num_Locations; i++)
+	{
+		if (!(occupiedTiles & (1 << i)))
+			emptySpaces.Add(BoardLocation(i));
+	}
+
+	return emptySpaces;
+}
+
+BoardConfiguration BoardConfiguration::GetTransformed(int _symmetry) const
+{
+	// Rotate or reflect both bitboards the same way
+	BoardConfiguration transformed;
+	transformed.xTiles = SYMMETRY_TABLE[_symmetry][xTiles];
+	transformed.oTiles = SYMMETRY_TABLE[_symmetry][oTiles];
+
+	// Rotating or reflecting the board doesn't change how many tiles there are or who won
+	transformed.numMoves = numMoves;
+	transformed.gameState = gameState;
+	return transformed;
+}
+
+BoardConfiguration BoardConfiguration::GetCanonical(int* _outSymmetry) const
+{
+	// The canonical layout is whichever of the 8 symmetric layouts has the lowest index
+	// Every layout in the same symmetry class therefore maps to the same canonical layout
+	BoardConfiguration canonical = *this;
+	int canonicalIndex = GetIndex();
+	int canonicalSymmetry = 0;
+
+	for (int symmetry = 1; symmetry < NUM_BOARD_SYMMETRIES; symmetry++)
 	{
-		// If this tile is empty, the game is not over yet so we can safely return out
-		// Using space to represent this
-		if (placedTiles[i] == '-')
-			return ' ';
+		BoardConfiguration transformed = GetTransformed(symmetry);
+		int transformedIndex = transformed.GetIndex();
+
+		if (transformedIndex < canonicalIndex)
+		{
+			canonical = transformed;
+			canonicalIndex = transformedIndex;
+			canonicalSymmetry = symmetry;
+		}
 	}
 
-	// If we made it here, then all of the tile locations have been filled and none of them triggered the win message. Therefore, we must have a tie
-	return '-';
+	// Optionally pass back which symmetry takes this layout to the canonical one so moves can be mapped back later
+	if (_outSymmetry != nullptr)
+		*_outSymmetry = canonicalSymmetry;
+
+	return canonical;
 }
 
-bool BoardConfiguration::operator==(const BoardConfiguration& other) 
+bool BoardConfiguration::operator==(const BoardConfiguration& other) const
 {
 	// Check if all of the placed tiles match eachother
-	return (placedTiles[0] == other.placedTiles[0] && placedTiles[1] == other.placedTiles[1] && placedTiles[2] == other.placedTiles[2] &&
-		placedTiles[3] == other.placedTiles[3] && placedTiles[4] == other.placedTiles[4] && placedTiles[5] == other.placedTiles[5] &&
-		placedTiles[6] == other.placedTiles[6] && placedTiles[7] == other.placedTiles[7] && placedTiles[8] == other.placedTiles[8]);
+	return (xTiles == other.xTiles && oTiles == other.oTiles);
+}
+
+
+
+//--- Static Methods ---//
+bool BoardConfiguration::IsWinningMask(BoardMask _tiles)
+{
+	return WIN_TABLE[_tiles & FULL_BOARD_MASK];
+}
+
+int BoardConfiguration::GetIndex(BoardMask _xTiles, BoardMask _oTiles)
+{
+	// Neutral tiles contribute 0, X tiles contribute 1 * 3^i, and O tiles contribute 2 * 3^i
+	return BASE3_TABLE[_xTiles] + 2 * BASE3_TABLE[_oTiles];
+}
+
+bool BoardConfiguration::IsReachable(BoardMask _xTiles, BoardMask _oTiles)
+{
+	// Both masks have to fit on the board without sharing a tile
+	if (((_xTiles | _oTiles) & ~FULL_BOARD_MASK) != 0 || (_xTiles & _oTiles) != 0)
+		return false;
+
+	int numXTiles = 0;
+	int numOTiles = 0;
+	for (int i = 0; i < BoardLocation::Num_Locations; i++)
+	{
+		numXTiles += (_xTiles >> i) & 1;
+		numOTiles += (_oTiles >> i) & 1;
+	}
+
+	// X always goes first, so X has either the same number of tiles as O or one more
+	// The game stops at the first line, so X can only have one if X moved last, and O can only have one if O moved last
+	if (numXTiles != numOTiles && numXTiles != numOTiles + 1)
+		return false;
+	if (WIN_TABLE[_xTiles] && numXTiles != numOTiles + 1)
+		return false;
+	if (WIN_TABLE[_oTiles] && numXTiles != numOTiles)
+		return false;
+
+	return true;
+}
+
+BoardLocation BoardConfiguration::TransformLocation(BoardLocation _location, int _symmetry)
+{
+	return BoardLocation(SYMMETRY_MAPS[_symmetry][_location]);
+}
+
+BoardLocation BoardConfiguration::InverseTransformLocation(BoardLocation _location, int _symmetry)
+{
+	// Find the location that the symmetry moves onto the given one
+	for (int i = 0; i < BoardLocation::Num_Locations; i++)
+	{
+		if (SYMMETRY_MAPS[_symmetry][i] == _location)
+			return BoardLocation(i);
+	}
+
+	return BoardLocation::Num_Locations;
 }
\ No newline at end of file
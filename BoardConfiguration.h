@@ -1,7 +1,7 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
-#include <GLM/glm.hpp>
 
 enum BoardLocation
 {
@@ -20,16 +20,69 @@ enum BoardLocation
 	Num_Locations
 };
 
+// One bit per board location, bit i is set if the tile at BoardLocation i is placed
+typedef uint16_t BoardMask;
+const BoardMask FULL_BOARD_MASK = 0x1FF;
+
+// Every layout has a unique base-3 index (neutral = 0, X = 1, O = 2 per location), so there are 3^9 possible indices
+const int NUM_BOARD_INDICES = 19683;
+
+// The board can be rotated and reflected 8 ways (the D4 symmetry group) without changing the game
+const int NUM_BOARD_SYMMETRIES = 8;
+
+// A win is worth WIN_SCORE_BASE minus the number of tiles on the board when it happened, so faster wins score higher and slower losses score less badly
+// The fastest possible win takes 5 tiles, so every score fits in [-(WIN_SCORE_BASE - 5), WIN_SCORE_BASE - 5]
+const int WIN_SCORE_BASE = 10;
+
+// Fixed-capacity list of moves that lives on the stack. There are never more than 9 empty spaces, so it never needs to allocate
+struct MoveList
+{
+	//--- Methods ---//
+	void Add(BoardLocation _move) { moves[numMoves++] = _move; }
+	int GetSize() const { return numMoves; }
+	BoardLocation operator[](int _index) const { return moves[_index]; }
+
+	//--- Data ---//
+	BoardLocation moves[BoardLocation::Num_Locations];
+	int numMoves = 0;
+};
+
 struct BoardConfiguration
 {
 	//--- Methods ---//
 	void Init();
-	char EvaluateWinner();
-	bool operator==(const BoardConfiguration& other);
+	char EvaluateWinner() const;
+	char ApplyMove(BoardLocation _location, char _tile);
+	char GetTile(BoardLocation _location) const;
+	void SetTile(BoardLocation _location, char _tile);
+	void SetTiles(BoardMask _xTiles, BoardMask _oTiles);
+	std::string GetPlacedTiles() const;
+	int GetIndex() const;
+	uint64_t GetHash() const;
+	int GetNumPlacedTiles() const;
+	int GetTerminalScore() const;
+	char GetTileToMove() const;
+	MoveList GetEmptySpaces() const;
+	BoardConfiguration GetTransformed(int _symmetry) const;
+	BoardConfiguration GetCanonical(int* _outSymmetry = nullptr) const;
+	bool operator==(const BoardConfiguration& other) const;
+
+	//--- Static Methods ---//
+	static bool IsWinningMask(BoardMask _tiles);
+	static int GetIndex(BoardMask _xTiles, BoardMask _oTiles);
+	static bool IsReachable(BoardMask _xTiles, BoardMask _oTiles);
+	static BoardLocation TransformLocation(BoardLocation _location, int _symmetry);
+	static BoardLocation InverseTransformLocation(BoardLocation _location, int _symmetry);
 
 	//--- Data ---//
-	// In the order as outlined from the enum above [	TL,TM,TR / CL,CM,CR / BL,BM,BR	]
-	// Either 'X', 'O', or '-' ('-' is for neutral)
-	//char placedTiles[BoardLocation::Num_Locations];
-	std::string placedTiles;
+	// Bitboards in the order as outlined from the enum above [	TL,TM,TR / CL,CM,CR / BL,BM,BR	] -> bits [ 0,1,2 / 3,4,5 / 6,7,8 ]
+	// A location that is set in neither mask is neutral ('-')
+	BoardMask xTiles;
+	BoardMask oTiles;
+
+	// How many tiles are placed and the result of the game so far (same values as EvaluateWinner() returns)
+	// Both are kept up to date as tiles are placed, so neither one ever needs the whole board to be rescanned
+	// This is why the bitboards should only be changed through ApplyMove(), SetTile() or SetTiles()
+	uint8_t numMoves;
+	char gameState;
 };
\ No newline at end of file
@@ -0,0 +1,278 @@
+#include <algorithm>
+#include "GameEngine.h"
+#include "RetrogradeSolver.h"
+#include "SolvedScoreTable.h"
+#include "WorkStealingPool.h"
+
+// Asks the CPU to start loading a cache line that will be needed soon. Compilers that don't have a prefetch just skip it
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define PREFETCH(address) _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#elif defined(__GNUC__) || defined(__clang__)
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address)
+#endif
+
+namespace
+{
+	// How many boards each task of a parallel batch answers. Smaller batches are answered on the calling thread
+	const size_t BOARDS_PER_TASK = 16384;
+
+	// How many boards ahead the scores are prefetched
+	const size_t PREFETCH_DISTANCE = 8;
+
+	// 3^i for every location, which is how much an X tile there adds to a layout's index. An O tile adds twice as much
+	const int PLACE_VALUES[BoardLocation::Num_Locations] = { 1, 3, 9, 27, 81, 243, 729, 2187, 6561 };
+
+	// Both kinds of board a batch can be given, read the same way
+	BoardMask GetXTiles(const BoardConfiguration& _layout) { return _layout.xTiles; }
+	BoardMask GetOTiles(const BoardConfiguration& _layout) { return _layout.oTiles; }
+	BoardMask GetXTiles(PackedBoard _board) { return BoardMask(_board & FULL_BOARD_MASK); }
+	BoardMask GetOTiles(PackedBoard _board) { return BoardMask((_board >> 16) & FULL_BOARD_MASK); }
+}
+
+
+
+//--- Constructors and Destructor ---//
+GameEngine::GameEngine()
+{
+	source = EngineSource_SolvedTable;
+}
+
+GameEngine::~GameEngine()
+{
+}
+
+
+
+//--- Methods ---//
+void GameEngine::Init(EngineSource _source, int _numThreads)
+{
+	// Fill in every score up front. Nothing is written after this, which is what lets the sessions share the engine without locking
+	source = _source;
+	scores.resize(NUM_BOARD_INDICES);
+
+	if (source == EngineSource_Retrograde)
+	{
+		// The solver's lists of layouts are only needed while solving, so only its scores are kept
+		RetrogradeSolver retrogradeSolver;
+		retrogradeSolver.Solve(_numThreads);
+		for (int i = 0; i < NUM_BOARD_INDICES; i++)
+			scores[i] = int8_t(retrogradeSolver.GetScore(i));
+	}
+	else
+	{
+		for (int i = 0; i < NUM_BOARD_INDICES; i++)
+			scores[i] = int8_t(SolvedScoreTable::GetScore(i));
+	}
+}
+
+BoardLocation GameEngine::ChooseMove(const BoardConfiguration& _layout, std::minstd_rand& _random) const
+{
+	// If the game is already over, there is no move to make
+	if (_layout.EvaluateWinner() != ' ')
+		return BoardLocation::Num_Locations;
+
+	// X wants the highest score and O wants the lowest, since the table always scores from X's perspective
+	char tileToMove = _layout.GetTileToMove();
+	bool isXToMove = (tileToMove == 'X');
+
+	// Look up the score of the layout that each empty space would lead to and keep all of the equally good ones
+	BoardLocation goodOptions[BoardLocation::Num_Locations];
+	int numGoodOptions = 0;
+	int bestScore = 0;
+	MoveList emptySpaces = _layout.GetEmptySpaces();
+	for (int i = 0; i < emptySpaces.GetSize(); i++)
+	{
+		BoardConfiguration childLayout = _layout;
+		childLayout.ApplyMove(emptySpaces[i], tileToMove);
+		int childScore = scores[childLayout.GetIndex()];
+
+		// Reset the good options list if there is a new best score
+		if (numGoodOptions == 0 || (isXToMove && childScore > bestScore) || (!isXToMove && childScore < bestScore))
+		{
+			bestScore = childScore;
+			numGoodOptions = 0;
+		}
+
+		if (childScore == bestScore)
+			goodOptions[numGoodOptions++] = emptySpaces[i];
+	}
+
+	// Randomly select one of the good moves with the caller's generator, so the engine itself is never written to
+	return goodOptions[_random() % numGoodOptions];
+}
+
+int GameEngine::GetScore(const BoardConfiguration& _layout) const {
+	return scores[_layout.GetIndex()];
+}
+
+void GameEngine::ChooseMoves(const BoardConfiguration* _layouts, size_t _numLayouts, BatchMoveResult* _outResults, WorkStealingPool* _pool) const
+{
+	ChooseMovesInChunks(_layouts, _numLayouts, _outResults, _pool);
+}
+
+void GameEngine::ChooseMoves(const PackedBoard* _boards, size_t _numBoards, BatchMoveResult* _outResults, WorkStealingPool* _pool) const
+{
+	ChooseMovesInChunks(_boards, _numBoards, _outResults, _pool);
+}
+
+
+
+//--- Setters and Getters ---//
+bool GameEngine::GetIsReady() const {
+	return !scores.empty();
+}
+
+EngineSource GameEngine::GetSource() const {
+	return source;
+}
+
+
+
+//--- Utility Functions ---//
+BatchMoveResult GameEngine::ChooseMove(BoardMask _xTiles, BoardMask _oTiles) const
+{
+	// Unlike ChooseMove() for a session, there is no random choice between equal moves, so the same board always gets the same answer
+	// Children are found by adding to the layout's index directly, which skips building a BoardConfiguration for each of them
+	// Boards from other services aren't trusted. Overlapping tiles would index past the end of the scores, and other impossible boards are scored as 0
+	if (!BoardConfiguration::IsReachable(_xTiles, _oTiles))
+		return { INVALID_BOARD_MOVE, 0, 0 };
+
+	int index = BoardConfiguration::GetIndex(_xTiles, _oTiles);
+	BatchMoveResult result = { uint8_t(BoardLocation::Num_Locations), scores[index], 0 };
+
+	// If the game is already over, there is no move to make
+	BoardMask placedTiles = _xTiles | _oTiles;
+	if (BoardConfiguration::IsWinningMask(_xTiles) || BoardConfiguration::IsWinningMask(_oTiles) || placedTiles == FULL_BOARD_MASK)
+		return result;
+
+	// X moves when both players have placed the same number of tiles
+	int numPlacedTiles = 0;
+	for (int i = 0; i < BoardLocation::Num_Locations; i++)
+		numPlacedTiles += (placedTiles >> i) & 1;
+	bool isXToMove = (numPlacedTiles % 2 == 0);
+	int tileValue = (isXToMove) ? 1 : 2;
+
+	// X wants the highest score and O wants the lowest
+	int bestScore = 0;
+	for (int i = 0; i < BoardLocation::Num_Locations; i++)
+	{
+		if (placedTiles & (1 << i))
+			continue;
+
+		int childScore = scores[index + tileValue * PLACE_VALUES[i]];
+		if (result.goodMoves == 0 || (isXToMove && childScore > bestScore) || (!isXToMove && childScore < bestScore))
+		{
+			bestScore = childScore;
+			result.bestMove = uint8_t(i);
+			result.goodMoves = 0;
+		}
+
+		if (childScore == bestScore)
+			result.goodMoves |= BoardMask(1 << i);
+	}
+
+	return result;
+}
+
+template<typename Board>
+void GameEngine::ChooseMovesInRange(const Board* _boards, size_t _start, size_t _end, BatchMoveResult* _outResults) const
+{
+	for (size_t i = _start; i < _end; i++)
+	{
+		// Start loading the scores for a board a little further on. Its children with a tile in the first few locations have indices
+		// just past its own, so one cache line covers the board and about half of its children
+		if (i + PREFETCH_DISTANCE < _end)
+		{
+			// The board hasn't been checked yet, so its index is kept inside the scores in case it is invalid
+			const Board& upcomingBoard = _boards[i + PREFETCH_DISTANCE];
+			int upcomingIndex = BoardConfiguration::GetIndex(GetXTiles(upcomingBoard) & FULL_BOARD_MASK, GetOTiles(upcomingBoard) & FULL_BOARD_MASK);
+			PREFETCH(scores.data() + std::min(upcomingIndex, NUM_BOARD_INDICES - 1));
+		}
+
+		_outResults[i] = ChooseMove(GetXTiles(_boards[i]), GetOTiles(_boards[i]));
+	}
+}
+
+template<typename Board>
+void GameEngine::ChooseMovesInChunks(const Board* _boards, size_t _numBoards, BatchMoveResult* _outResults, WorkStealingPool* _pool) const
+{
+	// Small batches aren't worth handing to other threads
+	if (_pool == nullptr || _numBoards <= BOARDS_PER_TASK)
+	{
+		ChooseMovesInRange(_boards, 0, _numBoards, _outResults);
+		return;
+	}
+
+	// Every board is answered on its own and the engine is only read, so each chunk can go to any worker
+	for (size_t start = 0; start < _numBoards; start += BOARDS_PER_TASK)
+	{
+		size_t end = std::min(start + BOARDS_PER_TASK, _numBoards);
+		_pool->Submit([this, _boards, start, end, _outResults](int /*_workerIndex*/)
+		{
+			ChooseMovesInRange(_boards, start, end, _outResults);
+		});
+	}
+
+	_pool->WaitForAll();
+}
+
+
+
+//--- Constructors and Destructor ---//
+GameSession::GameSession(const GameEngine* _engine, uint32_t _seed)
+{
+	engine = _engine;
+	currentLayout.Init();
+	randomEngine.seed(_seed);
+}
+
+GameSession::~GameSession()
+{
+}
+
+
+
+//--- Methods ---//
+void GameSession::Init(BoardConfiguration _rootConfiguration)
+{
+	// There is nothing to build, the session just starts tracking the game from here
+	currentLayout = _rootConfiguration;
+}
+
+bool GameSession::HandlePlayerMove(BoardLocation _move)
+{
+	// Reject moves that aren't on the board, go on a tile that is already taken, or come after the game is already over
+	if (_move < 0 || _move >= BoardLocation::Num_Locations || currentLayout.GetTile(_move) != '-' || currentLayout.EvaluateWinner() != ' ')
+		return false;
+
+	currentLayout.ApplyMove(_move, currentLayout.GetTileToMove());
+	return true;
+}
+
+BoardConfiguration GameSession::DecideNextMove()
+{
+	// The engine only reads its scores, and everything that changes lives in this session
+	BoardLocation bestMove = engine->ChooseMove(currentLayout, randomEngine);
+	if (bestMove != BoardLocation::Num_Locations)
+		currentLayout.ApplyMove(bestMove, currentLayout.GetTileToMove());
+
+	return currentLayout;
+}
+
+
+
+//--- Setters and Getters ---//
+void GameSession::SetEngine(const GameEngine* _engine) {
+	engine = _engine;
+}
+
+void GameSession::SetSeed(uint32_t _seed) {
+	randomEngine.seed(_seed);
+}
+
+const BoardConfiguration& GameSession::GetLayout() const {
+	return currentLayout;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "BoardConfiguration.h"
+#include "BatchClassifier.h"
+
+class WorkStealingPool;
+
+// Where a GameEngine gets the score of every layout from
+enum EngineSource
+{
+	// Copy the table that was solved at compile time
+	EngineSource_SolvedTable,
+
+	// Solve every layout at runtime with RetrogradeSolver
+	EngineSource_Retrograde
+};
+
+// The bestMove given for a board that can't come up in a real game, ex: X and O on the same tile. Its score and goodMoves are 0
+const uint8_t INVALID_BOARD_MOVE = 0xFF;
+
+// The answer for one board of a batch. 4 bytes, so a million answers take 4 MB
+struct BatchMoveResult
+{
+	uint8_t bestMove;		// The lowest numbered of the best moves, Num_Locations if the game is already over, or INVALID_BOARD_MOVE if the board can't come up in a game
+	int8_t score;			// The board's score with perfect play, from X's perspective
+	BoardMask goodMoves;	// Every move that is as good as bestMove, one bit per BoardLocation
+};
+
+// The solved game, built once and then shared read-only by any number of GameSessions
+// Init() fills in the score of every layout. After that nothing in the engine changes, so sessions on any number of threads can use it at the same time without locks
+// Scores are from X's perspective, the same as SolvedScoreTable
+class GameEngine
+{
+public:
+	//--- Constructors and Destructor ---//
+	GameEngine();
+	~GameEngine();
+
+	//--- Methods ---//
+	void Init(EngineSource _source, int _numThreads = 1);
+	BoardLocation ChooseMove(const BoardConfiguration& _layout, std::minstd_rand& _random) const;
+	int GetScore(const BoardConfiguration& _layout) const;
+	void ChooseMoves(const BoardConfiguration* _layouts, size_t _numLayouts, BatchMoveResult* _outResults, WorkStealingPool* _pool = nullptr) const;
+	void ChooseMoves(const PackedBoard* _boards, size_t _numBoards, BatchMoveResult* _outResults, WorkStealingPool* _pool = nullptr) const;
+
+	//--- Setters and Getters ---//
+	bool GetIsReady() const;
+	EngineSource GetSource() const;
+
+private:
+	//--- Data ---//
+	// One score per layout, indexed by BoardConfiguration::GetIndex(). Empty until Init() is called
+	std::vector<int8_t> scores;
+	EngineSource source;
+
+	//--- Utility Functions ---//
+	BatchMoveResult ChooseMove(BoardMask _xTiles, BoardMask _oTiles) const;
+	template<typename Board>
+	void ChooseMovesInRange(const Board* _boards, size_t _start, size_t _end, BatchMoveResult* _outResults) const;
+	template<typename Board>
+	void ChooseMovesInChunks(const Board* _boards, size_t _numBoards, BatchMoveResult* _outResults, WorkStealingPool* _pool) const;
+};
+
+// One game played with a shared GameEngine. A session only holds its own layout and random number generator (a few bytes),
+// so thousands of them can be kept at once and each one can be played on whichever thread is free without any locks
+// Like MinMaxTree, the session moves for whoever's turn it is, so the AI can play either side
+class GameSession
+{
+public:
+	//--- Constructors and Destructor ---//
+	GameSession(const GameEngine* _engine = nullptr, uint32_t _seed = 1);
+	~GameSession();
+
+	//--- Methods ---//
+	void Init(BoardConfiguration _rootConfiguration);
+	bool HandlePlayerMove(BoardLocation _move);
+	BoardConfiguration DecideNextMove();
+
+	//--- Setters and Getters ---//
+	void SetEngine(const GameEngine* _engine);
+	void SetSeed(uint32_t _seed);
+	const BoardConfiguration& GetLayout() const;
+
+private:
+	//--- Data ---//
+	const GameEngine* engine;
+	BoardConfiguration currentLayout;
+
+	// Picks between equally good moves. Every session has its own so sessions never share any state with each other
+	std::minstd_rand randomEngine;
+};
\ No newline at end of file
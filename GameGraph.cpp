@@ -0,0 +1,142 @@
+#include <cstring>
+#include "GameGraph.h"
+#include "MinMaxTree.h"
+
+static_assert(sizeof(GraphNode) == 12, "GraphNode should stay packed");
+static_assert(sizeof(GraphEdge) == 8, "GraphEdge should stay packed");
+
+
+
+//--- Constructors and Destructor ---//
+GameGraph::GameGraph()
+{
+}
+
+GameGraph::~GameGraph()
+{
+}
+
+
+
+//--- Methods ---//
+void GameGraph::Build()
+{
+	// Build the full tree from the empty board with X as the maximizing player, which gives scores from X's perspective
+	// The tree is only needed until it has been flattened, so it is thrown away at the end of this function
+	MinMaxTree tree;
+	BoardConfiguration emptyLayout = BoardConfiguration();
+	emptyLayout.Init();
+	tree.Init(emptyLayout);
+
+	BuildFromTable(tree.nodeTable, emptyLayout);
+}
+
+void GameGraph::BuildFromTable(const PositionTable& _nodeTable, const BoardConfiguration& _rootLayout)
+{
+	Clear();
+
+	// Number the nodes in breadth first order, starting from the root
+	// Layout indices are used to find which number each node was given
+	std::vector<MinMaxNode*> nodeOrder = std::vector<MinMaxNode*>();
+	MinMaxNode* rootNode = _nodeTable.Find(_rootLayout);
+	if (rootNode == nullptr)
+		return;
+
+	nodeOrder.push_back(rootNode);
+	nodeNumbers[_rootLayout.GetIndex()] = 0;
+
+	for (int i = 0; i < nodeOrder.size(); i++)
+	{
+		for (int j = 0; j < nodeOrder[i]->GetNumChildren(); j++)
+		{
+			MinMaxNode* child = nodeOrder[i]->GetChild(j);
+			int& childNumber = nodeNumbers[child->GetBoardLayout().GetIndex()];
+			if (childNumber == -1)
+			{
+				childNumber = int(nodeOrder.size());
+				nodeOrder.push_back(child);
+			}
+		}
+	}
+
+	// Flatten the nodes and their edges into the two arrays. Each node's edges are stored next to each other, in the same order as its children
+	nodes.resize(nodeOrder.size());
+	for (int i = 0; i < nodeOrder.size(); i++)
+	{
+		const BoardConfiguration& layout = nodeOrder[i]->GetBoardLayout();
+		GraphNode& node = nodes[i];
+		std::memset(&node, 0, sizeof(GraphNode));
+		node.xTiles = layout.xTiles;
+		node.oTiles = layout.oTiles;
+		node.score = int8_t(nodeOrder[i]->GetNodeScore());
+		node.firstEdge = uint32_t(edges.size());
+		node.numEdges = uint8_t(nodeOrder[i]->GetNumChildren());
+		node.flags = uint8_t(((layout.EvaluateWinner() != ' ') ? GraphNode_GameOver : 0) | ((layout.GetTileToMove() == 'X') ? GraphNode_XToMove : 0));
+
+		for (int j = 0; j < nodeOrder[i]->GetNumChildren(); j++)
+		{
+			GraphEdge edge;
+			std::memset(&edge, 0, sizeof(GraphEdge));
+			edge.childNode = uint32_t(nodeNumbers[nodeOrder[i]->GetChild(j)->GetBoardLayout().GetIndex()]);
+			edge.move = uint8_t(nodeOrder[i]->GetChildMove(j));
+			edges.push_back(edge);
+		}
+	}
+
+	// The edge array grew one edge at a time, so give back the spare capacity it was left with
+	edges.shrink_to_fit();
+}
+
+void GameGraph::Clear()
+{
+	nodes.clear();
+	edges.clear();
+	nodeNumbers.assign(NUM_BOARD_INDICES, -1);
+}
+
+int GameGraph::FindNode(const BoardConfiguration& _layout) const
+{
+	// Every layout maps straight to its node number, so there is nothing to search
+	if (nodeNumbers.empty())
+		return -1;
+
+	return nodeNumbers[_layout.GetIndex()];
+}
+
+
+
+//--- Setters and Getters ---//
+bool GameGraph::GetIsBuilt() const {
+	return !nodes.empty();
+}
+
+int GameGraph::GetNumNodes() const {
+	return int(nodes.size());
+}
+
+int GameGraph::GetNumEdges() const {
+	return int(edges.size());
+}
+
+int GameGraph::GetRootNode() const {
+	return 0;
+}
+
+const GraphNode& GameGraph::GetNode(int _index) const {
+	return nodes[_index];
+}
+
+const GraphEdge& GameGraph::GetEdge(int _index) const {
+	return edges[_index];
+}
+
+BoardConfiguration GameGraph::GetNodeLayout(int _index) const
+{
+	BoardConfiguration layout;
+	layout.SetTiles(nodes[_index].xTiles, nodes[_index].oTiles);
+	return layout;
+}
+
+size_t GameGraph::GetBytesUsed() const {
+	return nodes.size() * sizeof(GraphNode) + edges.size() * sizeof(GraphEdge) + nodeNumbers.size() * sizeof(int);
+}
\ No newline at end of file
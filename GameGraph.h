@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "BoardConfiguration.h"
+#include "PositionTable.h"
+
+// Bit flags stored with every node so common questions don't need the board to be looked at again
+enum GraphNodeFlags
+{
+	GraphNode_GameOver = 1 << 0,	// Someone has won or the board is full, so the node has no edges
+	GraphNode_XToMove = 1 << 1
+};
+
+// 12 bytes, so 5 nodes fit in a cache line
+struct GraphNode
+{
+	BoardMask xTiles;
+	BoardMask oTiles;
+	uint32_t firstEdge;			// The node's edges are edges[firstEdge] to edges[firstEdge + numEdges - 1]
+	int8_t score;				// From X's perspective, same as SolvedScoreTable
+	uint8_t numEdges;
+	uint8_t flags;				// GraphNodeFlags
+	uint8_t reserved;
+};
+
+struct GraphEdge
+{
+	uint32_t childNode;
+	uint8_t move;				// The BoardLocation that is filled in to get from the parent to the child
+	uint8_t reserved[3];
+};
+
+// The solved game graph flattened into two contiguous arrays (compressed sparse row), the same way GameSnapshot stores it on disk
+// Nodes are numbered in breadth first order from the root, so a node's children are usually next to each other in memory
+// Everything is referenced by index, so the whole graph can be walked without chasing any pointers
+class GameGraph
+{
+public:
+	//--- Constructors and Destructor ---//
+	GameGraph();
+	~GameGraph();
+
+	//--- Methods ---//
+	void Build();
+	void BuildFromTable(const PositionTable& _nodeTable, const BoardConfiguration& _rootLayout);
+	void Clear();
+	int FindNode(const BoardConfiguration& _layout) const;
+
+	//--- Setters and Getters ---//
+	bool GetIsBuilt() const;
+	int GetNumNodes() const;
+	int GetNumEdges() const;
+	int GetRootNode() const;
+	const GraphNode& GetNode(int _index) const;
+	const GraphEdge& GetEdge(int _index) const;
+	BoardConfiguration GetNodeLayout(int _index) const;
+	size_t GetBytesUsed() const;
+
+private:
+	//--- Data ---//
+	std::vector<GraphNode> nodes;
+	std::vector<GraphEdge> edges;
+
+	// The node number of every layout, indexed the same way as PositionTable. -1 if the layout isn't in the graph
+	std::vector<int> nodeNumbers;
+};
\ No newline at end of file
@@ -0,0 +1,316 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "GameSnapshot.h"
+#include "GameGraph.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(SnapshotHeader) == 40, "SnapshotHeader must match the file format exactly");
+static_assert(sizeof(SnapshotNode) == 12, "SnapshotNode must match the file format exactly");
+static_assert(sizeof(SnapshotEdge) == 8, "SnapshotEdge must match the file format exactly");
+
+namespace
+{
+	const char SNAPSHOT_MAGIC[8] = "TTTSNAP";
+	const uint32_t BYTE_ORDER_MARK = 0x01020304;
+}
+
+
+
+//--- Constructors and Destructor ---//
+GameSnapshot::GameSnapshot()
+{
+	mappedData = nullptr;
+	mappedSize = 0;
+	header = nullptr;
+	nodes = nullptr;
+	edges = nullptr;
+	fileHandle = nullptr;
+	mappingHandle = nullptr;
+}
+
+GameSnapshot::~GameSnapshot()
+{
+	Close();
+}
+
+
+
+//--- Methods ---//
+bool GameSnapshot::Open(const std::string& _path)
+{
+	// Only one file can be mapped at a time
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	HANDLE mapping = (GetFileSizeEx(file, &fileSize)) ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+	const void* view = (mapping != nullptr) ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (view == nullptr)
+	{
+		if (mapping != nullptr)
+			CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	fileHandle = file;
+	mappingHandle = mapping;
+	mappedData = static_cast<const char*>(view);
+	mappedSize = size_t(fileSize.QuadPart);
+#else
+	int file = open(_path.c_str(), O_RDONLY);
+	if (file < 0)
+		return false;
+
+	// Map the file read only and shared so every process gets the same physical pages. The descriptor isn't needed once it is mapped
+	struct stat fileInfo;
+	void* view = (fstat(file, &fileInfo) == 0 && fileInfo.st_size > 0) ? mmap(nullptr, size_t(fileInfo.st_size), PROT_READ, MAP_SHARED, file, 0) : MAP_FAILED;
+	close(file);
+	if (view == MAP_FAILED)
+		return false;
+
+	mappedData = static_cast<const char*>(view);
+	mappedSize = size_t(fileInfo.st_size);
+#endif
+
+	// Point the arrays into the mapped file using the offsets from the header
+	header = reinterpret_cast<const SnapshotHeader*>(mappedData);
+	if (!Validate())
+	{
+		std::printf("Snapshot %s is invalid or from a different version, ignoring it\n", _path.c_str());
+		Close();
+		return false;
+	}
+
+	nodes = reinterpret_cast<const SnapshotNode*>(mappedData + header->nodesOffset);
+	edges = reinterpret_cast<const SnapshotEdge*>(mappedData + header->edgesOffset);
+
+	// Map every layout to its node so FindNode() doesn't have to search
+	nodeNumbers.assign(NUM_BOARD_INDICES, -1);
+	for (uint32_t i = 0; i < header->numNodes; i++)
+		nodeNumbers[BoardConfiguration::GetIndex(nodes[i].xTiles, nodes[i].oTiles)] = int(i);
+
+	return true;
+}
+
+void GameSnapshot::Close()
+{
+	if (mappedData == nullptr)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(mappedData);
+	CloseHandle(mappingHandle);
+	CloseHandle(fileHandle);
+#else
+	munmap(const_cast<char*>(mappedData), mappedSize);
+#endif
+
+	mappedData = nullptr;
+	mappedSize = 0;
+	header = nullptr;
+	nodes = nullptr;
+	edges = nullptr;
+	fileHandle = nullptr;
+	mappingHandle = nullptr;
+	nodeNumbers.clear();
+}
+
+int GameSnapshot::FindNode(const BoardConfiguration& _layout) const
+{
+	// Every layout maps straight to its node number, so there is nothing to search
+	if (nodeNumbers.empty())
+		return -1;
+
+	return nodeNumbers[_layout.GetIndex()];
+}
+
+
+
+//--- Static Methods ---//
+bool GameSnapshot::Write(const std::string& _path)
+{
+	// Build the flattened graph, which already numbers the nodes in breadth first order from the empty board
+	GameGraph graph;
+	graph.Build();
+
+	// Copy the nodes and edges into the file format
+	std::vector<SnapshotNode> fileNodes = std::vector<SnapshotNode>(graph.GetNumNodes());
+	std::vector<SnapshotEdge> fileEdges = std::vector<SnapshotEdge>(graph.GetNumEdges());
+	for (int i = 0; i < graph.GetNumNodes(); i++)
+	{
+		const GraphNode& node = graph.GetNode(i);
+		SnapshotNode& fileNode = fileNodes[i];
+		std::memset(&fileNode, 0, sizeof(SnapshotNode));
+		fileNode.xTiles = node.xTiles;
+		fileNode.oTiles = node.oTiles;
+		fileNode.score = node.score;
+		fileNode.firstEdge = node.firstEdge;
+		fileNode.numEdges = node.numEdges;
+	}
+
+	for (int i = 0; i < graph.GetNumEdges(); i++)
+	{
+		SnapshotEdge& fileEdge = fileEdges[i];
+		std::memset(&fileEdge, 0, sizeof(SnapshotEdge));
+		fileEdge.childNode = graph.GetEdge(i).childNode;
+		fileEdge.move = graph.GetEdge(i).move;
+	}
+
+	// Fill in the header
+	SnapshotHeader fileHeader;
+	std::memset(&fileHeader, 0, sizeof(SnapshotHeader));
+	std::memcpy(fileHeader.magic, SNAPSHOT_MAGIC, sizeof(fileHeader.magic));
+	fileHeader.version = VERSION;
+	fileHeader.byteOrderMark = BYTE_ORDER_MARK;
+	fileHeader.numNodes = uint32_t(fileNodes.size());
+	fileHeader.numEdges = uint32_t(fileEdges.size());
+	fileHeader.rootNode = uint32_t(graph.GetRootNode());
+	fileHeader.nodesOffset = sizeof(SnapshotHeader);
+	fileHeader.edgesOffset = fileHeader.nodesOffset + uint32_t(fileNodes.size() * sizeof(SnapshotNode));
+	fileHeader.fileSize = fileHeader.edgesOffset + uint32_t(fileEdges.size() * sizeof(SnapshotEdge));
+
+	// Write to a temporary file first and then swap it into place, so other processes never map a half written snapshot
+	// The temporary file gets a unique name, so two processes writing the same snapshot at once don't write into each other's file
+#ifdef _WIN32
+	size_t directoryEnd = _path.find_last_of("/\\");
+	std::string directory = (directoryEnd == std::string::npos) ? std::string(".") : _path.substr(0, directoryEnd + 1);
+	char tempPathBuffer[MAX_PATH];
+	if (GetTempFileNameA(directory.c_str(), "ttt", 0, tempPathBuffer) == 0)
+		return false;
+
+	std::string tempPath = tempPathBuffer;
+	FILE* file = std::fopen(tempPath.c_str(), "wb");
+#else
+	std::string tempPath = _path + ".XXXXXX";
+	int fd = mkstemp(&tempPath[0]);
+	if (fd < 0)
+		return false;
+
+	// mkstemp() only lets the owner read the file, but the snapshot is meant to be mapped by other processes
+	fchmod(fd, 0644);
+	FILE* file = fdopen(fd, "wb");
+	if (file == nullptr)
+		close(fd);
+#endif
+
+	if (file == nullptr)
+	{
+		std::remove(tempPath.c_str());
+		return false;
+	}
+
+	bool succeeded = std::fwrite(&fileHeader, sizeof(SnapshotHeader), 1, file) == 1;
+	succeeded &= std::fwrite(fileNodes.data(), sizeof(SnapshotNode), fileNodes.size(), file) == fileNodes.size();
+	succeeded &= std::fwrite(fileEdges.data(), sizeof(SnapshotEdge), fileEdges.size(), file) == fileEdges.size();
+	succeeded &= std::fclose(file) == 0;
+
+#ifdef _WIN32
+	succeeded = succeeded && MoveFileExA(tempPath.c_str(), _path.c_str(), MOVEFILE_REPLACE_EXISTING);
+#else
+	succeeded = succeeded && std::rename(tempPath.c_str(), _path.c_str()) == 0;
+#endif
+
+	if (!succeeded)
+		std::remove(tempPath.c_str());
+
+	return succeeded;
+}
+
+
+
+//--- Setters and Getters ---//
+bool GameSnapshot::GetIsOpen() const {
+	return mappedData != nullptr;
+}
+
+int GameSnapshot::GetNumNodes() const {
+	return int(header->numNodes);
+}
+
+int GameSnapshot::GetRootNode() const {
+	return int(header->rootNode);
+}
+
+const SnapshotNode& GameSnapshot::GetNode(int _index) const {
+	return nodes[_index];
+}
+
+const SnapshotEdge& GameSnapshot::GetEdge(int _index) const {
+	return edges[_index];
+}
+
+BoardConfiguration GameSnapshot::GetNodeLayout(int _index) const
+{
+	BoardConfiguration layout;
+	layout.SetTiles(nodes[_index].xTiles, nodes[_index].oTiles);
+	return layout;
+}
+
+
+
+//--- Utility Functions ---//
+bool GameSnapshot::Validate() const
+{
+	// Make sure the file is big enough to hold the header before reading it
+	if (mappedSize < sizeof(SnapshotHeader))
+		return false;
+
+	// Reject files that aren't snapshots, are from another version, or were written on a machine with a different byte order
+	if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 || header->version != VERSION || header->byteOrderMark != BYTE_ORDER_MARK)
+		return false;
+
+	// Make sure the arrays actually fit inside the file
+	uint64_t nodesEnd = uint64_t(header->nodesOffset) + uint64_t(header->numNodes) * sizeof(SnapshotNode);
+	uint64_t edgesEnd = uint64_t(header->edgesOffset) + uint64_t(header->numEdges) * sizeof(SnapshotEdge);
+	if (header->fileSize != mappedSize || nodesEnd > mappedSize || edgesEnd > mappedSize || header->rootNode >= header->numNodes)
+		return false;
+
+	// The arrays have to be aligned since they are read in place
+	if (header->nodesOffset % alignof(SnapshotNode) != 0 || header->edgesOffset % alignof(SnapshotEdge) != 0)
+		return false;
+
+	// Finally, make sure every edge range and every edge stays inside the arrays so a damaged file can't send us out of bounds
+	const SnapshotNode* fileNodes = reinterpret_cast<const SnapshotNode*>(mappedData + header->nodesOffset);
+	const SnapshotEdge* fileEdges = reinterpret_cast<const SnapshotEdge*>(mappedData + header->edgesOffset);
+	for (uint32_t i = 0; i < header->numNodes; i++)
+	{
+		if (uint64_t(fileNodes[i].firstEdge) + fileNodes[i].numEdges > header->numEdges)
+			return false;
+
+		// Every node has to be a layout that can come up in a game, since its layout is used as an index when the snapshot is opened
+		if (!BoardConfiguration::IsReachable(fileNodes[i].xTiles, fileNodes[i].oTiles))
+			return false;
+	}
+
+	for (uint32_t i = 0; i < header->numEdges; i++)
+	{
+		if (fileEdges[i].childNode >= header->numNodes)
+			return false;
+	}
+
+	// The nodes are in breadth first order, so every child comes after its parent. A damaged file that breaks this could send a walk down the graph around in a loop
+	for (uint32_t i = 0; i < header->numNodes; i++)
+	{
+		for (uint32_t j = fileNodes[i].firstEdge; j < fileNodes[i].firstEdge + fileNodes[i].numEdges; j++)
+		{
+			if (fileEdges[j].childNode <= i)
+				return false;
+		}
+	}
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "BoardConfiguration.h"
+
+// On-disk layout of a solved game graph. Everything is referenced by index instead of by pointer so the file can be mapped at any address
+// The file is: [ SnapshotHeader ][ SnapshotNode x numNodes ][ SnapshotEdge x numEdges ]
+struct SnapshotHeader
+{
+	char magic[8];				// "TTTSNAP"
+	uint32_t version;			// Bumped whenever the layout or the meaning of the data changes
+	uint32_t byteOrderMark;		// Written as 0x01020304, used to reject snapshots from a machine with a different byte order
+	uint32_t numNodes;
+	uint32_t numEdges;
+	uint32_t rootNode;			// Index of the empty board
+	uint32_t nodesOffset;		// Byte offset of the node array from the start of the file
+	uint32_t edgesOffset;		// Byte offset of the edge array from the start of the file
+	uint32_t fileSize;
+};
+
+struct SnapshotNode
+{
+	BoardMask xTiles;
+	BoardMask oTiles;
+	uint32_t firstEdge;			// The node's edges are edges[firstEdge] to edges[firstEdge + numEdges - 1]
+	int8_t score;				// From X's perspective, same as SolvedScoreTable
+	uint8_t numEdges;
+	uint8_t reserved[2];
+};
+
+struct SnapshotEdge
+{
+	uint32_t childNode;
+	uint8_t move;				// The BoardLocation that is filled in to get from the parent to the child
+	uint8_t reserved[3];
+};
+
+// A read-only, memory mapped view of a solved game graph
+// Every process that opens the same file shares one copy of it in the OS page cache
+class GameSnapshot
+{
+public:
+	//--- Constructors and Destructor ---//
+	GameSnapshot();
+	~GameSnapshot();
+
+	//--- Methods ---//
+	bool Open(const std::string& _path);
+	void Close();
+	int FindNode(const BoardConfiguration& _layout) const;
+
+	//--- Static Methods ---//
+	static bool Write(const std::string& _path);
+
+	//--- Setters and Getters ---//
+	bool GetIsOpen() const;
+	int GetNumNodes() const;
+	int GetRootNode() const;
+	const SnapshotNode& GetNode(int _index) const;
+	const SnapshotEdge& GetEdge(int _index) const;
+	BoardConfiguration GetNodeLayout(int _index) const;
+
+	//--- Static Variables ---//
+	static const uint32_t VERSION = 2;
+
+private:
+	//--- Data ---//
+	const char* mappedData;
+	size_t mappedSize;
+	const SnapshotHeader* header;
+	const SnapshotNode* nodes;
+	const SnapshotEdge* edges;
+
+	// The node number of every layout, indexed the same way as PositionTable. -1 if the layout isn't in the snapshot
+	// The file doesn't store it, so each process fills it in from the node array when the snapshot is opened
+	std::vector<int> nodeNumbers;
+
+	// Handles needed to unmap the file again
+	void* fileHandle;
+	void* mappingHandle;
+
+	//--- Utility Functions ---//
+	bool Validate() const;
+};
\ No newline at end of file
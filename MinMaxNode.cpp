@@ -2,41 +2,68 @@
 #include <iostream>
 #include "MinMaxTree.h"
 
-//--- Static Variables ---//
-MinMaxTree* MinMaxNode::tree = nullptr;
-
-
-
 //--- Constructors and Destructor ---//
-MinMaxNode::MinMaxNode(bool _isMaxNode, bool _aiIsX, BoardConfiguration _boardLayout)
+MinMaxNode::MinMaxNode(MinMaxTree* _tree, bool _isMaxNode, bool _aiIsX, BoardConfiguration _boardLayout, bool _buildChildren)
 {
 	// Store this node's data
+	tree = _tree;
 	isMaxNode = _isMaxNode;
 	boardLayout = _boardLayout;
-	nodeScore = (isMaxNode) ? -10 : 10;
+	nodeScore = (isMaxNode) ? -WIN_SCORE_BASE : WIN_SCORE_BASE;
+	isLeafNode = false;
+	isExpanded = false;
+	isScored = false;
+	children = nullptr;
+	childMoves = nullptr;
+	numChildren = 0;
+	for (int i = 0; i < BoardLocation::Num_Locations; i++)
+		moveToChild[i] = -1;
+
+	// When the tree is built in parallel, the tree adds the node to the node list and expands it on a worker thread instead
+	if (!_buildChildren)
+		return;
 
 	// Add this node to the node list
-	tree->nodeTable.insert(std::pair<std::string, MinMaxNode*>(_boardLayout.placedTiles, this));
+	tree->nodeTable.Insert(_boardLayout, this);
+
+	// Create all of the child nodes. This recursively builds the whole subtree, so this node's score is final afterwards
+	ExpandChildren(_aiIsX, tree->nodeArena, nullptr);
+	isScored = true;
+}
+
+MinMaxNode::~MinMaxNode()
+{
+	// Nodes live in the tree's node arena, which releases all of them at once in MinMaxTree::Cleanup()
+}
 
+
+
+//--- Methods ---//
+void MinMaxNode::ExpandChildren(bool _aiIsX, NodeArena& _arena, WorkStealingPool* _pool)
+{
 	// Determine if the AI is X or O
 	char aiTileType = (_aiIsX) ? 'X' : 'O';
 
 	// Determine the empty spaces that can be filled in the layout
-	std::vector<BoardLocation> emptySpaces = FindEmptySpaces();
+	MoveList emptySpaces = FindEmptySpaces();
+	isExpanded = true;
 
 	// If there are no empty spaces, this is a leaf node. We need to determine the score of this node based on if this is a win or a loss
 	// Alternatively, if the game is over, it is also a leaf node (the game can end in as few as 5 moves)
-	if (boardLayout.EvaluateWinner() != ' ' || emptySpaces.size() == 0)
+	if (boardLayout.EvaluateWinner() != ' ' || emptySpaces.GetSize() == 0)
 	{
 		isLeafNode = true;
+		isScored = true;
 		DetermineLeafScore(aiTileType);
 		return;
 	}
-	else
-		isLeafNode = false;
+
+	// There is at most one child per empty space, so the child lists can be sized up front
+	children = _arena.CreateArray<MinMaxNode*>(emptySpaces.GetSize());
+	childMoves = _arena.CreateArray<BoardLocation>(emptySpaces.GetSize());
 
 	// If there are empty spaces, create child nodes for each of them
-	for (int i = 0; i < emptySpaces.size(); i++)
+	for (int i = 0; i < emptySpaces.GetSize(); i++)
 	{
 		// Create a new board layout with the empty space filled in with whatever the next row turn would be
 		char tileToAddToChild = '-';
@@ -56,97 +83,206 @@ MinMaxNode::MinMaxNode(bool _isMaxNode, bool _aiIsX, BoardConfiguration _boardLa
 		}
 		BoardConfiguration childLayout = FillEmptySpace(boardLayout, emptySpaces[i], tileToAddToChild);
 
+		// When using symmetry, all rotations and reflections of the child share the node for their canonical layout
+		if (tree->GetSettings().useSymmetry)
+		{
+			childLayout = childLayout.GetCanonical();
+
+			// Symmetric moves (ex: any corner on the empty board) lead to the same canonical child, so only keep it once
+			// The duplicate move still needs to lead somewhere, so it is pointed at the existing child's slot
+			int duplicateSlot = -1;
+			for (int j = 0; j < numChildren && duplicateSlot == -1; j++)
+			{
+				if (children[j]->boardLayout == childLayout)
+					duplicateSlot = j;
+			}
+
+			if (duplicateSlot != -1)
+			{
+				moveToChild[emptySpaces[i]] = int8_t(duplicateSlot);
+				continue;
+			}
+		}
+
 		// Check if the child node layout already exists in the list. If so, just merge and use that node instead
-		auto childNode = tree->nodeTable.find(childLayout.placedTiles);
-		if (childNode == tree->nodeTable.end())
+		MinMaxNode* childNode = tree->nodeTable.Find(childLayout);
+		if (childNode == nullptr && tree->GetSettings().expandLazily)
 		{
-			// Create a new node and assign it the layout
+			// When expanding lazily, the child is created without any children of its own. Its subtree is only built if it is needed later
+			childNode = _arena.Create<MinMaxNode>(tree, !isMaxNode, _aiIsX, childLayout, false);
+			tree->nodeTable.Insert(childLayout, childNode);
+		}
+		else if (childNode == nullptr && _pool == nullptr)
+		{
+			// Create a new node in the arena and assign it the layout
 			// MinMax trees flip min-max so assign it the opposite of this node
-			children.push_back(new MinMaxNode(!isMaxNode, _aiIsX, childLayout));
+			childNode = _arena.Create<MinMaxNode>(tree, !isMaxNode, _aiIsX, childLayout);
 		}
-		else
+		else if (childNode == nullptr)
 		{
-			// If a node with the layout is already cached, just use it instead
-			children.push_back(childNode->second);
+			// When building in parallel, create the node without its children and then try to claim its slot in the node list
+			// If another thread claimed it first, their node is used instead. Otherwise, expanding it becomes a new task
+			MinMaxNode* newNode = _arena.Create<MinMaxNode>(tree, !isMaxNode, _aiIsX, childLayout, false);
+			childNode = tree->nodeTable.InsertOrFind(childLayout, newNode);
+
+			if (childNode == newNode)
+			{
+				_pool->Submit([newNode, _aiIsX, _pool](int _workerIndex)
+				{
+					newNode->ExpandChildren(_aiIsX, newNode->tree->GetWorkerArena(_workerIndex), _pool);
+				});
+			}
 		}
 
+		// Store the child, along with the move that leads to it so the tree can apply it to the actual board later
+		// If a node with the layout was already cached, it is just shared instead
+		children[numChildren] = childNode;
+		childMoves[numChildren] = emptySpaces[i];
+		moveToChild[emptySpaces[i]] = int8_t(numChildren);
+		numChildren++;
+
+		// When building in parallel or lazily, the children might not be scored yet so they are scored later instead
+		if (_pool != nullptr || tree->GetSettings().expandLazily)
+			continue;
+
 		// Get the child score for alpha-beta pruning
-		int childScore = children[children.size() - 1]->GetNodeScore();
+		int childScore = childNode->GetNodeScore();
 
 		// Assign the new best score if need be
-		nodeScore = (_isMaxNode) ? std::max(nodeScore, childScore) : std::min(nodeScore, childScore);
+		nodeScore = (isMaxNode) ? std::max(nodeScore, childScore) : std::min(nodeScore, childScore);
 	}
 }
 
-MinMaxNode::~MinMaxNode()
+void MinMaxNode::ScoreFromChildren()
 {
-	// Cleanup is handled within MinMaxTree::Cleanup()
+	// Leaf nodes were already scored when they were expanded
+	if (!isLeafNode)
+		DetermineBranchScore();
+
+	isScored = true;
 }
 
+int MinMaxNode::EvaluateLazily(bool _aiIsX)
+{
+	// Scores are memoized, so a node that has been reached through another move order is only scored once
+	if (isScored)
+		return nodeScore;
+
+	// Create the children the first time the node is needed
+	if (!isExpanded)
+		ExpandChildren(_aiIsX, tree->nodeArena, nullptr);
 
+	// Score the children one at a time. As soon as one of them wins on the very next move for whoever is moving here, the rest can't change the score,
+	// so they are left unexpanded. The score is still exact since nothing can beat the fastest possible win
+	if (!isLeafNode)
+	{
+		int fastestWinScore = WIN_SCORE_BASE - (boardLayout.GetNumPlacedTiles() + 1);
+		int bestPossibleScore = (isMaxNode) ? fastestWinScore : -fastestWinScore;
+		nodeScore = (isMaxNode) ? -WIN_SCORE_BASE : WIN_SCORE_BASE;
+
+		for (int i = 0; i < numChildren; i++)
+		{
+			int childScore = children[i]->EvaluateLazily(_aiIsX);
+			nodeScore = (isMaxNode) ? std::max(nodeScore, childScore) : std::min(nodeScore, childScore);
+
+			if (nodeScore == bestPossibleScore)
+				break;
+		}
+	}
+
+	isScored = true;
+	return nodeScore;
+}
+
+void MinMaxNode::PrepareChildrenLazily(bool _aiIsX, bool _scoreChildren)
+{
+	// Create the children if they haven't been yet so the tree can move to one of them
+	if (!isExpanded)
+		ExpandChildren(_aiIsX, tree->nodeArena, nullptr);
+
+	// To make a decision, every child needs a score, not just enough of them to score this node
+	if (_scoreChildren)
+	{
+		for (int i = 0; i < numChildren; i++)
+			children[i]->EvaluateLazily(_aiIsX);
+	}
+}
 
-//--- Methods ---//
 MinMaxNode* MinMaxNode::TransitionToLayout(BoardConfiguration _boardLayout)
 {
 	// Loop through the children and find the one that matches the given board layout. That's the new current node
-	for (int i = 0; i < children.size(); i++)
+	for (int i = 0; i < numChildren; i++)
 	{
 		// If the board layout matches, return the child
 		if (children[i]->boardLayout == _boardLayout)
 			return children[i];
 	}
+
+	// None of the children match, so the layout can't be reached from here
+	return nullptr;
+}
+
+MinMaxNode* MinMaxNode::PlayMove(BoardLocation _move) const
+{
+	// Look the child up directly by the move instead of comparing layouts. Moves that aren't possible from here return nullptr
+	if (_move < 0 || _move >= BoardLocation::Num_Locations || moveToChild[_move] == -1)
+		return nullptr;
+
+	return children[moveToChild[_move]];
 }
 
-MinMaxNode* MinMaxNode::MakeDecision()
+MinMaxNode* MinMaxNode::MakeDecision(BoardLocation& _chosenMove, std::minstd_rand& _random)
 {
 	if (isLeafNode)
+	{
+		_chosenMove = BoardLocation::Num_Locations;
 		return this;
+	}
 
 	// If this is a min node, the 'best' score is the lowest, otherwise it is the highest
-	std::vector<MinMaxNode*> goodOptions = std::vector<MinMaxNode*>();
-	goodOptions.push_back(children[0]);
+	// There is at most one good option per child, so they fit in a fixed array on the stack
+	int goodOptions[BoardLocation::Num_Locations];
+	int numGoodOptions = 1;
+	goodOptions[0] = 0;
 	int bestScore = children[0]->GetNodeScore();
-	int bestIndex = 0;
-	for (int i = 1; i < children.size(); i++)
+	for (int i = 1; i < numChildren; i++)
 	{
 		// Get the score from the node
 		int childScore = children[i]->GetNodeScore();
 
 		// Determine if it is better than the currently stored best score
 		// If this is a max node, 'better' is higher. For min nodes, 'better' is lower
-		if (isMaxNode)
-		{
-			if (childScore > bestScore)
-			{
-				bestScore = childScore;
-				bestIndex = i;
-
-				//reset the good options list since we have a new best score
-				goodOptions.clear();
-				goodOptions.push_back(children[i]);
-			}
-			else if (childScore == bestScore)
-				goodOptions.push_back(children[i]);
-		}
-		else
+		bool isBetter = (isMaxNode) ? (childScore > bestScore) : (childScore < bestScore);
+		if (isBetter)
 		{
-			if (childScore < bestScore)
-			{
-				bestScore = childScore;
-				bestIndex = i;
+			bestScore = childScore;
 
-				//reset the good options list since we have a new best score
-				goodOptions.clear();
-				goodOptions.push_back(children[i]);
-			}
-			else if (childScore == bestScore)
-				goodOptions.push_back(children[i]);
+			//reset the good options list since we have a new best score
+			numGoodOptions = 0;
+			goodOptions[numGoodOptions++] = i;
 		}
+		else if (childScore == bestScore)
+			goodOptions[numGoodOptions++] = i;
 	}
 
 	// Randomly select one of the good children
-	int index = rand() % goodOptions.size();
-	return goodOptions[index];
+	int index = goodOptions[_random() % numGoodOptions];
+	_chosenMove = childMoves[index];
+	return children[index];
+}
+
+void MinMaxNode::Recycle(NodeArena& _arena)
+{
+	// The child lists were sized for every empty space when the node was expanded, even if symmetry kept fewer children
+	if (children != nullptr)
+	{
+		int childCapacity = BoardLocation::Num_Locations - boardLayout.GetNumPlacedTiles();
+		_arena.DestroyArray(children, childCapacity);
+		_arena.DestroyArray(childMoves, childCapacity);
+	}
+
+	// Give the node itself back last since nothing in it can be used afterwards
+	_arena.Destroy(this);
 }
 
 
@@ -156,47 +292,52 @@ int MinMaxNode::GetNodeScore() const {
 	return nodeScore;
 }
 
-BoardConfiguration MinMaxNode::GetBoardLayout() const {
+const BoardConfiguration& MinMaxNode::GetBoardLayout() const {
 	return boardLayout;
 }
 
+int MinMaxNode::GetNumChildren() const {
+	return numChildren;
+}
 
+MinMaxNode* MinMaxNode::GetChild(int _index) const {
+	return children[_index];
+}
 
-//--- Utility Functions ---//
-std::vector<BoardLocation> MinMaxNode::FindEmptySpaces()
-{
-	// Create a vector to hold the positions
-	std::vector<BoardLocation> emptySpaces = std::vector<BoardLocation>();
+BoardLocation MinMaxNode::GetChildMove(int _index) const {
+	return childMoves[_index];
+}
 
-	// Loop through the board layout and find the spaces
-	for (int i = 0; i < BoardLocation::Num_Locations; i++)
-	{
-		// If the space is empty, add it to the list
-		if (boardLayout.placedTiles[i] == '-')
-			emptySpaces.push_back(BoardLocation(i));
-	}
+bool MinMaxNode::GetIsScored() const {
+	return isScored;
+}
 
-	// Return the list of empty spaces
-	return emptySpaces;
+
+
+//--- Utility Functions ---//
+MoveList MinMaxNode::FindEmptySpaces() const
+{
+	// The list is a fixed size and returned by value, so finding the moves never touches the heap
+	return boardLayout.GetEmptySpaces();
 }
 
-BoardConfiguration MinMaxNode::FillEmptySpace(BoardConfiguration _boardLayout, BoardLocation _emptySpace, char _aiTileType)
+BoardConfiguration MinMaxNode::FillEmptySpace(const BoardConfiguration& _boardLayout, BoardLocation _emptySpace, char _aiTileType) const
 {
-	// Fill in the location on the board layout
-	_boardLayout.placedTiles[_emptySpace] = _aiTileType;
+	// Fill in the location on a copy of the board layout
+	BoardConfiguration filledLayout = _boardLayout;
+	filledLayout.ApplyMove(_emptySpace, _aiTileType);
 
 	// Return the configuration
-	return _boardLayout;
+	return filledLayout;
 }
 
 void MinMaxNode::DetermineLeafScore(char _aiTileType)
 {
-	// Otherwise, we need to determine the winner for this board layout
-	char winner = boardLayout.EvaluateWinner();
-
-	// Assign a point value based on the winner
-	// Winner is AI = 1, winner is player = -1, game ties = 0
-	nodeScore = (winner == '-') ? 0 : (winner == _aiTileType) ? 1 : -1;
+	// Assign a point value based on the winner, flipping X's score around if the AI is O
+	// Winner is AI = WIN_SCORE_BASE - placed tiles, winner is player = the negative of that, game ties = 0
+	// Quicker wins are worth more and slower losses cost less, so the AI finishes games fast and drags out games it can't win
+	int terminalScore = boardLayout.GetTerminalScore();
+	nodeScore = (_aiTileType == 'X') ? terminalScore : -terminalScore;
 }
 
 void MinMaxNode::DetermineBranchScore()
@@ -207,7 +348,7 @@ void MinMaxNode::DetermineBranchScore()
 
 	// Loop through the rest of the children and see if there is a better score
 	// 'Better' means either less or greater, depending on if this is a max or min node
-	for (int i = 1; i < children.size(); i++)
+	for (int i = 1; i < numChildren; i++)
 	{
 		// Get the score from the node
 		int childScore = children[i]->GetNodeScore();
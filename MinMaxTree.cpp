@@ -1,95 +1,601 @@
+#include <chrono>
 #include <iostream>
 #include <ctime>
 #include "MinMaxTree.h"
+#include "SolvedScoreTable.h"
 
 //--- Static Variables ---//
 //std::unordered_map<std::string, int> MinMaxTree::transpositionTable = std::unordered_map<std::string, int>();
 
+// How many nodes each task scores after a parallel build
+static const int NODES_PER_TASK = 256;
+
+// The node graph is always scored from X's perspective. X is the max player, so MakeDecision picks the right move for either role
+static const bool GRAPH_SCORED_FOR_X = true;
+
+namespace
+{
+	// Picks the best edge out of a node of a flat graph, which is either a GameSnapshot or a GameGraph since they are laid out the same way
+	// Returns -1 if the node has no edges
+	template<typename Graph>
+	int ChooseGraphEdge(const Graph& _graph, int _nodeIndex, bool _isXToMove, std::minstd_rand& _random)
+	{
+		// Leaf nodes have no edges, so there is no move to make
+		const auto& node = _graph.GetNode(_nodeIndex);
+		if (node.numEdges == 0)
+			return -1;
+
+		// X wants the highest score and O wants the lowest, since flat graphs always score from X's perspective
+		// Keep all of the equally good edges
+		int goodOptions[BoardLocation::Num_Locations];
+		int numGoodOptions = 0;
+		int bestScore = 0;
+		for (uint32_t i = node.firstEdge; i < node.firstEdge + node.numEdges; i++)
+		{
+			int childScore = _graph.GetNode(_graph.GetEdge(i).childNode).score;
+
+			// Reset the good options list if there is a new best score
+			if (numGoodOptions == 0 || (_isXToMove && childScore > bestScore) || (!_isXToMove && childScore < bestScore))
+			{
+				bestScore = childScore;
+				numGoodOptions = 0;
+			}
+
+			if (childScore == bestScore)
+				goodOptions[numGoodOptions++] = int(i);
+		}
+
+		// Randomly select one of the good edges
+		return goodOptions[_random() % numGoodOptions];
+	}
+
+	// Finds the node for a layout in a flat graph, checking the current node's edges first since the layout is usually one move on from it
+	template<typename Graph>
+	int FindGraphNode(const Graph& _graph, int _currentNode, const BoardConfiguration& _layout)
+	{
+		if (_currentNode != -1)
+		{
+			const auto& node = _graph.GetNode(_currentNode);
+			for (uint32_t i = node.firstEdge; i < node.firstEdge + node.numEdges; i++)
+			{
+				int childIndex = int(_graph.GetEdge(i).childNode);
+				if (_graph.GetNodeLayout(childIndex) == _layout)
+					return childIndex;
+			}
+		}
+
+		// Otherwise, search the whole graph for it
+		return _graph.FindNode(_layout);
+	}
+}
+
 
 
 //--- Constructors and Destructor ---//
 MinMaxTree::MinMaxTree()
 {
-
+	rootNode = nullptr;
+	currentNode = nullptr;
+	currentSymmetry = 0;
+	currentSnapshotNode = -1;
+	currentGraphNode = -1;
+	lastBuildTime = 0.0;
+	numTasksStolen = 0;
 }
 
 MinMaxTree::~MinMaxTree()
 {
-
+	// The node arena gives its memory back when it is destroyed
 }
 
 
 
 //--- Methods ---//
-void MinMaxTree::Init(bool _aiIsX, BoardConfiguration _rootConfiguration, bool _startMax)
+void MinMaxTree::Init(BoardConfiguration _rootConfiguration)
 {
-	// Reserve space in the node table to prevent rehashing and speed it up
-	// If the AI moves first, there are more possibilities so it needs to reserve more
-	if (_aiIsX)
-		nodeTable.reserve(6000);
-	else
-		nodeTable.reserve(2000);
-	
-	// Going to time how long it takes to create the tree
-	auto startTime = time(nullptr);
+	// Nothing has been built for this game yet
+	lastBuildTime = 0.0;
 
-	// The nodes need to be able to reference the tree later when adding to the node list
-	MinMaxNode::tree = this;
+	// The solved engine is filled in the first time it is needed, either from the compile-time table or by running the retrograde solver
+	// The snapshot backend falls back to it if the snapshot can't be used, so it is filled in for that too
+	if (settings.backend == Backend_SolvedTable || settings.backend == Backend_Snapshot || settings.backend == Backend_Retrograde)
+	{
+		EngineSource source = (settings.backend == Backend_Retrograde) ? EngineSource_Retrograde : EngineSource_SolvedTable;
+		if (!solvedEngine.GetIsReady() || solvedEngine.GetSource() != source)
+		{
+			auto startTime = std::chrono::steady_clock::now();
+			solvedEngine.Init(source, settings.numBuildThreads);
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+			lastBuildTime = elapsed.count();
+		}
+	}
+
+	// The packed table is made from the solved table the first time it is needed
+	if (settings.backend == Backend_PackedTable && !packedTable.GetIsBuilt())
+	{
+		auto startTime = std::chrono::steady_clock::now();
+		packedTable.Build();
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+		lastBuildTime = elapsed.count();
+	}
 
-	// If the root node has already been created before, we might need to rebuild the tree
-	// This means we need to clean up the existing tree first
-	if (rootNode != nullptr)
+	// The solved table already knows the score of every layout, so there is nothing to build. Just start tracking the game
+	if (settings.backend == Backend_SolvedTable || settings.backend == Backend_AlphaBeta || settings.backend == Backend_Retrograde || settings.backend == Backend_PackedTable)
 	{
-		// If the new root configuration is the same though, we can just go back to the beginning and not regenerate the full tree
-		if (_rootConfiguration == rootNode->GetBoardLayout())
+		currentLayout = _rootConfiguration;
+		return;
+	}
+
+	// When using a snapshot, map it the first time it is needed instead of building anything
+	if (settings.backend == Backend_Snapshot)
+	{
+		currentLayout = _rootConfiguration;
+
+		// If there is no valid snapshot yet, build the tree once and write it so every other process can just map it
+		if (!snapshot.GetIsOpen() && !snapshot.Open(settings.snapshotPath))
 		{
-			// Go back to the root node but don't rebuild
-			currentNode = rootNode;
-			return;
+			std::cout << "Writing snapshot to " << settings.snapshotPath << std::endl;
+			if (!GameSnapshot::Write(settings.snapshotPath) || !snapshot.Open(settings.snapshotPath))
+				std::cout << "Snapshot could not be written, falling back to the solved table" << std::endl;
 		}
-		else
+
+		// Find where the game starts in the snapshot
+		currentSnapshotNode = (snapshot.GetIsOpen()) ? FindGraphNode(snapshot, -1, _rootConfiguration) : -1;
+		return;
+	}
+
+	// When using the flat graph, build it the first time it is needed and then just find where the game starts in it
+	if (settings.backend == Backend_Graph)
+	{
+		currentLayout = _rootConfiguration;
+		if (!graph.GetIsBuilt())
 		{
-			// Since we do have to rebuild the full tree, we need to cleanup the existing one first
-			Cleanup();
+			auto startTime = std::chrono::steady_clock::now();
+			graph.Build();
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+			lastBuildTime = elapsed.count();
 		}
+
+		currentGraphNode = FindGraphNode(graph, -1, _rootConfiguration);
+		return;
 	}
 
-	// Create the root node. This will start the chain reaction of all of the child nodes getting created
-	rootNode = new MinMaxNode(_startMax, _aiIsX, _rootConfiguration);
+	// The game starts from the root configuration. When using symmetry, the nodes only store the canonical version of it
+	currentLayout = _rootConfiguration;
+	currentSymmetry = 0;
+	BoardConfiguration rootLayout = (settings.useSymmetry) ? _rootConfiguration.GetCanonical(&currentSymmetry) : _rootConfiguration;
 
-	// We are starting at the root node
-	currentNode = rootNode;
+	// There is one graph of every layout reachable from the empty board, scored from X's perspective, so it works for either role
+	// It is only built the first time it is needed. After that, every game just attaches to the node for its starting layout
+	// Whose turn it is comes from the layout itself, so the AI can play either side of it
+	// A lazy tree can have had its root reclaimed during an earlier game, but the nodes it still has are kept instead of starting over
+	if (rootNode == nullptr && nodeTable.GetSize() == 0)
+	{
+		auto startTime = std::chrono::steady_clock::now();
+		BuildGraph();
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+		lastBuildTime = elapsed.count();
+	}
 
-	// Output stats about the tree creation
-	auto endTime = time(nullptr);
-	std::cout << "\n\n";
-	std::cout << "Start Time: " << startTime << std::endl;
-	std::cout << "End Time: " << endTime << std::endl;
-	std::cout << "Time taken: " << endTime - startTime << std::endl;
-	std::cout << "Node List Size: " << nodeTable.size() << std::endl;
+	// Attach to the node for the starting layout
+	// When expanding lazily, it might not have been reached yet (or been reclaimed) so it is created on its own. Its subtree is filled in as the game needs it
+	// Otherwise the full graph has every layout that can come up in a game, so if it isn't there, currentNode stays null and the tree won't make moves
+	currentNode = nodeTable.Find(rootLayout);
+	if (currentNode == nullptr && settings.expandLazily)
+	{
+		currentNode = nodeArena.Create<MinMaxNode>(this, rootLayout.GetTileToMove() == 'X', GRAPH_SCORED_FOR_X, rootLayout, false);
+		nodeTable.Insert(rootLayout, currentNode);
+	}
+}
+
+bool MinMaxTree::HandlePlayerMove(BoardLocation _move)
+{
+	// Reject moves that aren't on the board, go on a tile that is already taken, or come after the game is already over
+	if (_move < 0 || _move >= BoardLocation::Num_Locations || currentLayout.GetTile(_move) != '-' || currentLayout.EvaluateWinner() != ' ')
+		return false;
+
+	BoardConfiguration newLayout = currentLayout;
+	newLayout.ApplyMove(_move, currentLayout.GetTileToMove());
+
+	// There are no nodes to move through when using a score table or searching every move
+	if (settings.backend == Backend_SolvedTable || settings.backend == Backend_AlphaBeta || settings.backend == Backend_Retrograde || settings.backend == Backend_PackedTable)
+	{
+		currentLayout = newLayout;
+		return true;
+	}
+
+	// When using the flat graph, just move the index to the matching node instead
+	if (settings.backend == Backend_Graph)
+	{
+		currentGraphNode = FindGraphNode(graph, currentGraphNode, newLayout);
+		currentLayout = newLayout;
+		return true;
+	}
+
+	// Same with the snapshot
+	if (settings.backend == Backend_Snapshot)
+	{
+		currentSnapshotNode = (snapshot.GetIsOpen()) ? FindGraphNode(snapshot, currentSnapshotNode, newLayout) : -1;
+		currentLayout = newLayout;
+		return true;
+	}
+
+	// Without a current node, there is nothing to move from
+	if (currentNode == nullptr)
+		return false;
+
+	// When expanding lazily, the current node's children might not exist yet
+	if (settings.expandLazily)
+		currentNode->PrepareChildrenLazily(GRAPH_SCORED_FOR_X, false);
+
+	// Move straight to the child for the move. When using symmetry, the move first has to be mapped onto the node's canonical layout
+	BoardLocation nodeMove = (settings.useSymmetry) ? BoardConfiguration::TransformLocation(_move, currentSymmetry) : _move;
+	MinMaxNode* nextNode = currentNode->PlayMove(nodeMove);
+	if (nextNode == nullptr)
+		return false;
+
+	// Keep track of the actual layout so the AI's moves can be mapped back onto it later
+	// The new layout can be a different transform of the child's canonical layout, so store the new symmetry
+	currentNode = nextNode;
+	currentLayout = newLayout;
+	if (settings.useSymmetry)
+		currentLayout.GetCanonical(&currentSymmetry);
+
+	// The layouts the player didn't choose can never come up again this game
+	if (settings.reclaimUnreachable)
+		ReclaimUnreachableNodes();
+
+	return true;
 }
 
-void MinMaxTree::HandlePlayerMove(BoardConfiguration _newLayout)
+bool MinMaxTree::HandlePlayerMove(BoardConfiguration _newLayout)
 {
-	// Move down the tree to the node that matches the new board configuration
-	currentNode = currentNode->TransitionToLayout(_newLayout);
+	// Work out which move was made. The new layout has to be the current one plus exactly one tile for whoever's turn it is
+	BoardMask currentTiles = currentLayout.xTiles | currentLayout.oTiles;
+	BoardMask newTiles = _newLayout.xTiles | _newLayout.oTiles;
+	BoardMask placedTile = newTiles & ~currentTiles;
+	BoardMask playerTiles = (currentLayout.GetTileToMove() == 'X') ? _newLayout.xTiles : _newLayout.oTiles;
+	if ((currentTiles & ~newTiles) != 0 || (_newLayout.xTiles & currentLayout.oTiles) != 0 || (_newLayout.oTiles & currentLayout.xTiles) != 0 || !(placedTile & playerTiles))
+		return false;
+
+	for (int i = 0; i < BoardLocation::Num_Locations; i++)
+	{
+		if (placedTile == (1 << i))
+			return HandlePlayerMove(BoardLocation(i));
+	}
+
+	// More than one tile was placed
+	return false;
 }
 
 BoardConfiguration MinMaxTree::DecideNextMove()
 {
+	// Use the default budget from the settings
+	return DecideNextMove(settings.moveLimits);
+}
+
+BoardConfiguration MinMaxTree::DecideNextMove(SearchLimits _limits)
+{
+	// When searching every move, run the alpha-beta search from the current layout. Its stats can be read with GetAlphaBetaSearch() afterwards
+	// The search deepens one move at a time and returns the best move from the deepest search that finished within the budget
+	// The other backends only do a lookup per move so they don't need a budget
+	if (settings.backend == Backend_AlphaBeta)
+	{
+		BoardLocation bestMove = alphaBetaSearch.FindBestMove(currentLayout, _limits);
+		if (bestMove != BoardLocation::Num_Locations)
+			currentLayout.ApplyMove(bestMove, currentLayout.GetTileToMove());
+
+		return currentLayout;
+	}
+
+	// When using the flat graph, pick the best edge out of the current node and follow it
+	if (settings.backend == Backend_Graph)
+	{
+		int bestEdge = (currentGraphNode != -1) ? ChooseGraphEdge(graph, currentGraphNode, (graph.GetNode(currentGraphNode).flags & GraphNode_XToMove) != 0, randomEngine) : -1;
+		if (bestEdge != -1)
+		{
+			const GraphEdge& edge = graph.GetEdge(bestEdge);
+			currentLayout.ApplyMove(BoardLocation(edge.move), currentLayout.GetTileToMove());
+			currentGraphNode = int(edge.childNode);
+		}
+
+		return currentLayout;
+	}
+
+	// When using the snapshot, pick the best edge out of the current node and follow it
+	if (settings.backend == Backend_Snapshot && currentSnapshotNode != -1)
+	{
+		int bestEdge = ChooseGraphEdge(snapshot, currentSnapshotNode, currentLayout.GetTileToMove() == 'X', randomEngine);
+		if (bestEdge != -1)
+		{
+			const SnapshotEdge& edge = snapshot.GetEdge(bestEdge);
+			currentLayout.ApplyMove(BoardLocation(edge.move), currentLayout.GetTileToMove());
+			currentSnapshotNode = int(edge.childNode);
+		}
+
+		return currentLayout;
+	}
+
+	// When using the solved table, just pick the best move by looking up the score of each possible next layout
+	// This is also the fallback if the snapshot couldn't be used, since both of them score from X's perspective
+	// The retrograde solver's table works the same way
+	if (settings.backend == Backend_SolvedTable || settings.backend == Backend_Snapshot || settings.backend == Backend_Retrograde)
+	{
+		BoardLocation bestMove = solvedEngine.ChooseMove(currentLayout, randomEngine);
+		if (bestMove != BoardLocation::Num_Locations)
+			currentLayout.ApplyMove(bestMove, currentLayout.GetTileToMove());
+
+		return currentLayout;
+	}
+
+	// The packed table works the same way, except it only knows who wins so it also looks one move ahead to pick between equal outcomes
+	if (settings.backend == Backend_PackedTable)
+	{
+		BoardLocation bestMove = packedTable.ChooseMove(currentLayout, randomEngine);
+		if (bestMove != BoardLocation::Num_Locations)
+			currentLayout.ApplyMove(bestMove, currentLayout.GetTileToMove());
+
+		return currentLayout;
+	}
+
+	// Without a current node, there is nothing to move from. This happens if Init was given a layout that isn't in the graph
+	if (currentNode == nullptr)
+		return currentLayout;
+
+	// When expanding lazily, make sure all of the current node's children exist and are scored before choosing between them
+	if (settings.expandLazily)
+		currentNode->PrepareChildrenLazily(GRAPH_SCORED_FOR_X, true);
+
 	// Get the new current node after the tree has decided where to move to
-	currentNode = currentNode->MakeDecision();
+	// The chosen move is relative to the node's layout, which is the canonical one when using symmetry
+	BoardLocation chosenMove = BoardLocation::Num_Locations;
+	currentNode = currentNode->MakeDecision(chosenMove, randomEngine);
 
-	// Return the board layout at the new current node
-	return currentNode->GetBoardLayout();
+	// If the game is already over, there is no move to make
+	if (chosenMove == BoardLocation::Num_Locations)
+		return currentLayout;
+
+	// Undo the stored symmetry to find where the move goes on the actual board, then place the tile there
+	if (settings.useSymmetry)
+		chosenMove = BoardConfiguration::InverseTransformLocation(chosenMove, currentSymmetry);
+	currentLayout.ApplyMove(chosenMove, currentLayout.GetTileToMove());
+
+	// The new layout can be a different transform of the child's canonical layout, so store the new symmetry
+	if (settings.useSymmetry)
+		currentLayout.GetCanonical(&currentSymmetry);
+
+	// The layouts the AI didn't choose can never come up again this game
+	if (settings.reclaimUnreachable)
+		ReclaimUnreachableNodes();
+
+	// Return the new board layout
+	return currentLayout;
 }
 
 void MinMaxTree::Cleanup()
 {
-	// Delete all of the nodes in the table and clear up the memory
-	for (auto it = nodeTable.begin(); it != nodeTable.end(); it++)
-		delete it->second;
+	// All of the nodes and their child lists live in the arena, so they can all be released in one step
+	// The arena keeps its blocks so rebuilding the tree doesn't need to allocate them again
+	nodeArena.Reset();
+	for (int i = 0; i < workerArenas.size(); i++)
+		workerArenas[i]->Reset();
 
 	// Reset the node list for later
-	nodeTable.clear();
+	nodeTable.Clear();
+	rootNode = nullptr;
+	currentNode = nullptr;
+}
+
+int MinMaxTree::CompareWithSolvedTable() const
+{
+	// Check every node in the tree against the compile-time solution and count how many disagree
+	// Both of them score from X's perspective
+	int numMismatches = 0;
+	for (int i = 0; i < NUM_BOARD_INDICES; i++)
+	{
+		MinMaxNode* node = nodeTable.GetNodeAtIndex(i);
+		if (node == nullptr || !node->GetIsScored())
+			continue;
+
+		if (node->GetNodeScore() != SolvedScoreTable::GetScore(i))
+			numMismatches++;
+	}
+
+	return numMismatches;
+}
+
+
+
+//--- Setters and Getters ---//
+void MinMaxTree::SetSettings(MinMaxTreeSettings _settings)
+{
+	// The existing tree was built with the old settings so it can't be reused
+	if (_settings.backend != settings.backend || _settings.useSymmetry != settings.useSymmetry || _settings.expandLazily != settings.expandLazily)
+		Cleanup();
+
+	// Unmap the old snapshot so the new one is opened next time
+	if (_settings.snapshotPath != settings.snapshotPath)
+		snapshot.Close();
+
+	// Reclaiming from a fully built graph would mean building it again for every game, so it only happens when expanding lazily
+	settings = _settings;
+	if (!settings.expandLazily)
+		settings.reclaimUnreachable = false;
+}
+
+const MinMaxTreeSettings& MinMaxTree::GetSettings() const {
+	return settings;
+}
+
+void MinMaxTree::SetSeed(uint32_t _seed)
+{
+	// Seed every source of randomness the tree has, so the same seed always plays the same moves
+	randomEngine.seed(_seed);
+	alphaBetaSearch.SetSeed(_seed);
+}
+
+void MinMaxTree::SetSharedTable(TranspositionTable* _sharedTable)
+{
+	// Backend_AlphaBeta stores what it finds here instead of in its own table, so trees searching on other threads can use it too
+	alphaBetaSearch.SetSharedTable(_sharedTable);
+}
+
+NodeArena& MinMaxTree::GetWorkerArena(int _workerIndex) {
+	return *workerArenas[_workerIndex];
+}
+
+const AlphaBetaSearch& MinMaxTree::GetAlphaBetaSearch() const {
+	return alphaBetaSearch;
+}
+
+const GameGraph& MinMaxTree::GetGameGraph() const {
+	return graph;
+}
+
+const PackedScoreTable& MinMaxTree::GetPackedScoreTable() const {
+	return packedTable;
+}
+
+double MinMaxTree::GetLastBuildTime() const {
+	return lastBuildTime;
+}
+
+int MinMaxTree::GetNumTasksStolen() const {
+	return numTasksStolen;
+}
+
+int MinMaxTree::GetNumLiveNodes() const {
+	return nodeTable.GetSize();
+}
+
+
+
+//--- Utility Functions ---//
+void MinMaxTree::BuildGraph()
+{
+	// Going to time how long it takes to create the tree
+	auto startTime = time(nullptr);
+
+	// Clean up whatever is left of an earlier graph first
+	if (nodeTable.GetSize() > 0)
+		Cleanup();
+
+	// The graph always starts from the empty board, where X moves first
+	BoardConfiguration emptyLayout = BoardConfiguration();
+	emptyLayout.Init();
+
+	// Create the root node. This will start the chain reaction of all of the child nodes getting created
+	// When expanding lazily, only the root is created here and the rest of the nodes are created as the game needs them
+	if (settings.expandLazily)
+	{
+		rootNode = nodeArena.Create<MinMaxNode>(this, true, GRAPH_SCORED_FOR_X, emptyLayout, false);
+		nodeTable.Insert(emptyLayout, rootNode);
+	}
+	else if (settings.numBuildThreads > 1)
+		BuildInParallel(GRAPH_SCORED_FOR_X, true, emptyLayout);
+	else
+		rootNode = nodeArena.Create<MinMaxNode>(this, true, GRAPH_SCORED_FOR_X, emptyLayout);
+
+	// Output stats about the tree creation
+	auto endTime = time(nullptr);
+	std::cout << "\n\n";
+	std::cout << "Start Time: " << startTime << std::endl;
+	std::cout << "End Time: " << endTime << std::endl;
+	std::cout << "Time taken: " << endTime - startTime << std::endl;
+	std::cout << "Node List Size: " << nodeTable.GetSize() << std::endl;
+	size_t nodeMemory = nodeArena.GetBytesUsed();
+	for (int i = 0; i < workerArenas.size(); i++)
+		nodeMemory += workerArenas[i]->GetBytesUsed();
+	std::cout << "Node Memory: " << nodeMemory << " bytes" << std::endl;
+}
+
+void MinMaxTree::BuildInParallel(bool _aiIsX, bool _startMax, BoardConfiguration _rootLayout)
+{
+	// Make sure every worker has an arena to create its nodes in
+	while (workerArenas.size() < settings.numBuildThreads)
+		workerArenas.push_back(std::unique_ptr<NodeArena>(new NodeArena()));
+
+	// Create the root without its children and hand it to the pool. Expanding a node submits a task for each new child,
+	// so the subtrees spread across the workers, and the shared node list makes sure each layout is only expanded once
+	WorkStealingPool pool(settings.numBuildThreads);
+	rootNode = nodeArena.Create<MinMaxNode>(this, _startMax, _aiIsX, _rootLayout, false);
+	nodeTable.Insert(_rootLayout, rootNode);
+	pool.Submit([this, _aiIsX, &pool](int _workerIndex)
+	{
+		rootNode->ExpandChildren(_aiIsX, GetWorkerArena(_workerIndex), &pool);
+	});
+	pool.WaitForAll();
+
+	// Now that every node exists, score them one layer at a time starting from the deepest
+	// Every child has exactly one more tile than its parent, so each layer only depends on the one below it and can be scored in parallel
+	std::vector<MinMaxNode*> layers[BoardLocation::Num_Locations + 1];
+	for (int i = 0; i < NUM_BOARD_INDICES; i++)
+	{
+		MinMaxNode* node = nodeTable.GetNodeAtIndex(i);
+		if (node != nullptr)
+			layers[node->GetBoardLayout().GetNumPlacedTiles()].push_back(node);
+	}
+
+	for (int layer = BoardLocation::Num_Locations; layer >= 0; layer--)
+	{
+		std::vector<MinMaxNode*>& layerNodes = layers[layer];
+		for (int start = 0; start < layerNodes.size(); start += NODES_PER_TASK)
+		{
+			pool.Submit([&layerNodes, start](int /*_workerIndex*/)
+			{
+				for (int i = start; i < layerNodes.size() && i < start + NODES_PER_TASK; i++)
+					layerNodes[i]->ScoreFromChildren();
+			});
+		}
+
+		pool.WaitForAll();
+	}
+
+	numTasksStolen = pool.GetNumSteals();
+}
+
+void MinMaxTree::ReclaimUnreachableNodes()
+{
+	// If the current node is missing, we can't tell what is still reachable
+	if (currentNode == nullptr)
+		return;
+
+	// Mark every node that can still be reached from the current node. Every node has a unique layout, so the layout index identifies it
+	// Nodes with more than one parent are marked as long as any of their parents are reachable, so shared nodes survive
+	// Both lists are kept between moves so this doesn't allocate once they have grown to size
+	isReachable.assign(NUM_BOARD_INDICES, false);
+	nodesToVisit.clear();
+	isReachable[currentNode->GetBoardLayout().GetIndex()] = true;
+	nodesToVisit.push_back(currentNode);
+	while (!nodesToVisit.empty())
+	{
+		MinMaxNode* node = nodesToVisit.back();
+		nodesToVisit.pop_back();
+
+		for (int i = 0; i < node->GetNumChildren(); i++)
+		{
+			MinMaxNode* child = node->GetChild(i);
+			int childIndex = child->GetBoardLayout().GetIndex();
+			if (!isReachable[childIndex])
+			{
+				isReachable[childIndex] = true;
+				nodesToVisit.push_back(child);
+			}
+		}
+	}
+
+	// Everything else in the node list is unreachable, so take it out of the list and give its memory to the arena's pool
+	// Nodes from a parallel build live in the worker arenas, but they all get reset together so it is safe to pool them in the main one
+	for (int i = 0; i < NUM_BOARD_INDICES; i++)
+	{
+		MinMaxNode* node = nodeTable.GetNodeAtIndex(i);
+		if (node == nullptr || isReachable[i])
+			continue;
+
+		if (node == rootNode)
+			rootNode = nullptr;
+
+		nodeTable.Remove(node->GetBoardLayout());
+		node->Recycle(nodeArena);
+	}
 }
\ No newline at end of file
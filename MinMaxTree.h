@@ -1,11 +1,70 @@
 #pragma once
 
+#include <random>
+#include <string>
 #include <vector>
-#include <unordered_map>
 #include "BoardConfiguration.h"
+#include "GameSnapshot.h"
+#include "GameGraph.h"
+#include "AlphaBetaSearch.h"
+#include "GameEngine.h"
+#include "PackedScoreTable.h"
+#include "WorkStealingPool.h"
+#include "PositionTable.h"
+#include "NodeArena.h"
 
 class MinMaxNode;
 
+enum TreeBackend
+{
+	// Build the full tree of MinMaxNodes at runtime in Init()
+	Backend_NodeTree,
+
+	// Look moves up in the table that was solved at compile time. No tree is built at all
+	Backend_SolvedTable,
+
+	// Walk the solved graph in a memory mapped snapshot file that is shared by every process on the machine
+	Backend_Snapshot,
+
+	// Search from the current layout on every move with alpha-beta pruning and a transposition table. No tree is built at all
+	Backend_AlphaBeta,
+
+	// Build the node tree once, flatten it into a GameGraph and then walk the flat arrays instead of the node objects
+	Backend_Graph,
+
+	// Solve every layout backwards one ply at a time with RetrogradeSolver (on numBuildThreads threads) and look moves up in the result
+	Backend_Retrograde,
+
+	// Look moves up in a table that only stores who wins each layout, 2 bits per layout. The smallest backend by far
+	Backend_PackedTable
+};
+
+struct MinMaxTreeSettings
+{
+	// Where the scores for each layout come from
+	TreeBackend backend = Backend_NodeTree;
+
+	// Store one node per symmetry class instead of one per layout (about 8x fewer nodes)
+	bool useSymmetry = false;
+
+	// The snapshot file used by Backend_Snapshot. If it doesn't exist yet, the first process to need it writes it
+	std::string snapshotPath = "TicTacToe.snapshot";
+
+	// The default time or node budget for each move made by Backend_AlphaBeta. No limit by default
+	SearchLimits moveLimits = SearchLimits();
+
+	// Build the node tree on this many threads. 1 builds it recursively on the calling thread
+	int numBuildThreads = 1;
+
+	// Only create and score the nodes that the game actually needs, starting from the current node. Ignores numBuildThreads
+	bool expandLazily = false;
+
+	// After every move, give the nodes that can no longer be reached from the current node back to the arena's pool
+	// Nodes that are shared with a layout that is still reachable are kept. Only used together with expandLazily, since a full graph
+	// would have to be built again for every game, and the lazy tree just creates the nodes the next game needs
+	bool reclaimUnreachable = false;
+};
+
 class MinMaxTree
 {
 public:
@@ -14,49 +73,130 @@ public:
 	~MinMaxTree();
 
 	//--- Methods ---//
-	void Init(bool _aiIsX, BoardConfiguration _rootConfiguration, bool _startMax = true);
-	void HandlePlayerMove(BoardConfiguration _newLayout);
+	void Init(BoardConfiguration _rootConfiguration);
+	bool HandlePlayerMove(BoardLocation _move);
+	bool HandlePlayerMove(BoardConfiguration _newLayout);
 	BoardConfiguration DecideNextMove();
+	BoardConfiguration DecideNextMove(SearchLimits _limits);
 	void Cleanup();
+	int CompareWithSolvedTable() const;
+
+	//--- Setters and Getters ---//
+	void SetSettings(MinMaxTreeSettings _settings);
+	const MinMaxTreeSettings& GetSettings() const;
+	void SetSeed(uint32_t _seed);
+	void SetSharedTable(TranspositionTable* _sharedTable);
+	NodeArena& GetWorkerArena(int _workerIndex);
+	const AlphaBetaSearch& GetAlphaBetaSearch() const;
+	const GameGraph& GetGameGraph() const;
+	const PackedScoreTable& GetPackedScoreTable() const;
+	double GetLastBuildTime() const;
+	int GetNumTasksStolen() const;
+	int GetNumLiveNodes() const;
 
 	//--- Public Variables ---//
-	std::unordered_map<std::string, MinMaxNode*> nodeTable;
+	PositionTable nodeTable;
+	NodeArena nodeArena;
 
 private:
 	//--- Data ---//
+	MinMaxTreeSettings settings;
 	MinMaxNode* rootNode;
 	MinMaxNode* currentNode;
+
+	// The actual layout of the game. When using symmetry, the nodes only store the canonical layout
+	// currentSymmetry is the transform that takes currentLayout to currentNode's canonical layout
+	BoardConfiguration currentLayout;
+	int currentSymmetry;
+
+	// The mapped snapshot and the index of the current node inside it, or -1 if the snapshot couldn't be used
+	GameSnapshot snapshot;
+	int currentSnapshotNode;
+
+	// Used by Backend_AlphaBeta. It keeps its transposition table between moves and between games
+	AlphaBetaSearch alphaBetaSearch;
+
+	// Used by Backend_Graph. It is built the first time it is needed and kept for every game after that
+	GameGraph graph;
+	int currentGraphNode;
+
+	// How long the last call to Init() spent building, in milliseconds. 0 if there was nothing left to build
+	double lastBuildTime;
+
+	// Used by Backend_SolvedTable and Backend_Retrograde, and by Backend_Snapshot if the snapshot can't be used
+	// It is filled in the first time it is needed and kept for every game after that
+	GameEngine solvedEngine;
+
+	// Used by Backend_PackedTable. It is packed the first time it is needed and kept for every game after that
+	PackedScoreTable packedTable;
+
+	// Picks between equally good moves. Every tree has its own, so trees on different threads don't share any state
+	std::minstd_rand randomEngine;
+
+	// Each thread of a parallel build gets its own arena so creating nodes doesn't need a lock
+	std::vector<std::unique_ptr<NodeArena>> workerArenas;
+
+	// How many tasks the workers of the last parallel build took from each other
+	int numTasksStolen;
+
+	// Scratch lists for ReclaimUnreachableNodes(), kept so they don't have to be allocated again on every move
+	std::vector<bool> isReachable;
+	std::vector<MinMaxNode*> nodesToVisit;
+
+	//--- Utility Functions ---//
+	void BuildGraph();
+	void BuildInParallel(bool _aiIsX, bool _startMax, BoardConfiguration _rootLayout);
+	void ReclaimUnreachableNodes();
 };
 
 class MinMaxNode
 {
 public:
 	//--- Constructors and Destructor ---//
-	MinMaxNode(bool _isMaxNode, bool _aiIsX, BoardConfiguration _boardLayout);
+	MinMaxNode(MinMaxTree* _tree, bool _isMaxNode, bool _aiIsX, BoardConfiguration _boardLayout, bool _buildChildren = true);
 	~MinMaxNode();
 
 	//--- Methods ---//
+	void ExpandChildren(bool _aiIsX, NodeArena& _arena, WorkStealingPool* _pool);
+	void ScoreFromChildren();
+	int EvaluateLazily(bool _aiIsX);
+	void PrepareChildrenLazily(bool _aiIsX, bool _scoreChildren);
 	MinMaxNode* TransitionToLayout(BoardConfiguration _boardLayout);
-	MinMaxNode* MakeDecision();
+	MinMaxNode* PlayMove(BoardLocation _move) const;
+	MinMaxNode* MakeDecision(BoardLocation& _chosenMove, std::minstd_rand& _random);
+	void Recycle(NodeArena& _arena);
 
 	//--- Setters and Getters ---//
 	int GetNodeScore() const;
-	BoardConfiguration GetBoardLayout() const;
-
-	//--- Static Variables ---//
-	static MinMaxTree* tree;
+	const BoardConfiguration& GetBoardLayout() const;
+	int GetNumChildren() const;
+	MinMaxNode* GetChild(int _index) const;
+	BoardLocation GetChildMove(int _index) const;
+	bool GetIsScored() const;
 
 private:
 	//--- Data ---//
-	std::vector<MinMaxNode*> children;
+	// The tree this node belongs to, for its node list, arena and settings. Every tree is separate, so several can be built at once
+	MinMaxTree* tree;
+
+	// Both child lists are allocated from the tree's node arena and hold numChildren entries
+	MinMaxNode** children;
+	BoardLocation* childMoves;
+	int numChildren;
+
+	// Which child slot each move leads to, or -1 if the move isn't possible from here
+	// When using symmetry, moves that lead to the same canonical child share its slot
+	int8_t moveToChild[BoardLocation::Num_Locations];
 	bool isLeafNode;
+	bool isExpanded;
+	bool isScored;
 	int nodeScore;
 	bool isMaxNode;
 	BoardConfiguration boardLayout;
 
 	//--- Uility Functions ---//
-	std::vector<BoardLocation> FindEmptySpaces();
-	BoardConfiguration FillEmptySpace(BoardConfiguration _boardLayout, BoardLocation _emptySpace, char _aiTileType);
+	MoveList FindEmptySpaces() const;
+	BoardConfiguration FillEmptySpace(const BoardConfiguration& _boardLayout, BoardLocation _emptySpace, char _aiTileType) const;
 	void DetermineLeafScore(char _aiTile);
 	void DetermineBranchScore();
 };
\ No newline at end of file
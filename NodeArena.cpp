@@ -0,0 +1,103 @@
+#include <cstdint>
+#include "NodeArena.h"
+
+//--- Constructors and Destructor ---//
+NodeArena::NodeArena()
+{
+	currentBlock = 0;
+	currentOffset = 0;
+	bytesUsed = 0;
+
+	// Make room for enough block pointers up front that building a full tree never has to grow the list
+	blocks.reserve(INITIAL_BLOCK_CAPACITY);
+}
+
+NodeArena::~NodeArena()
+{
+	Release();
+}
+
+
+
+//--- Methods ---//
+void* NodeArena::Allocate(size_t _size, size_t _alignment)
+{
+	// Reuse a recycled allocation of the same size if there is one
+	// Different types can share a size, so the recycled memory is only used if it is aligned well enough for this one
+	if (_size < freeLists.size() && !freeLists[_size].empty() && reinterpret_cast<uintptr_t>(freeLists[_size].back()) % _alignment == 0)
+	{
+		void* memory = freeLists[_size].back();
+		freeLists[_size].pop_back();
+		bytesUsed += _size;
+		return memory;
+	}
+
+	// Nothing in the tree is ever bigger than a block, so this only needs to find room in the current block or move to the next one
+	while (true)
+	{
+		// Create a new block if every existing one has been used up
+		if (currentBlock == blocks.size())
+		{
+			blocks.push_back(new char[BLOCK_SIZE]);
+			currentOffset = 0;
+		}
+
+		// Round the offset up to the requested alignment
+		size_t alignedOffset = (currentOffset + _alignment - 1) & ~(_alignment - 1);
+
+		// If it fits in this block, bump the offset and hand it out
+		if (alignedOffset + _size <= BLOCK_SIZE)
+		{
+			currentOffset = alignedOffset + _size;
+			bytesUsed += _size;
+			return blocks[currentBlock] + alignedOffset;
+		}
+
+		// Otherwise, move on to the next block
+		currentBlock++;
+		currentOffset = 0;
+	}
+}
+
+void NodeArena::Recycle(void* _memory, size_t _size)
+{
+	// Keep the memory in the pool for its size. It is only given back to the system along with the rest of the blocks
+	if (_size >= freeLists.size())
+		freeLists.resize(_size + 1);
+
+	freeLists[_size].push_back(_memory);
+	bytesUsed -= _size;
+}
+
+void NodeArena::Reset()
+{
+	// Rewind to the start of the first block. The blocks are kept around so the next tree doesn't need to allocate them again
+	currentBlock = 0;
+	currentOffset = 0;
+	bytesUsed = 0;
+
+	// Anything that was recycled is part of the blocks being rewound, so the pool is emptied as well
+	for (int i = 0; i < freeLists.size(); i++)
+		freeLists[i].clear();
+}
+
+void NodeArena::Release()
+{
+	// Actually give all of the blocks back
+	for (int i = 0; i < blocks.size(); i++)
+		delete[] blocks[i];
+
+	blocks.clear();
+	Reset();
+}
+
+
+
+//--- Setters and Getters ---//
+size_t NodeArena::GetBytesUsed() const {
+	return bytesUsed;
+}
+
+size_t NodeArena::GetBytesReserved() const {
+	return blocks.size() * BLOCK_SIZE;
+}
\ No newline at end of file
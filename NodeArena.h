@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Bump allocator for the tree's nodes and child lists
+// Memory is handed out from large blocks and is only ever given back to the system all at once, so tearing down a tree is O(1)
+// Individual allocations can also be recycled, which puts them in a pool that is reused for the next allocation of the same size
+class NodeArena
+{
+public:
+	//--- Constructors and Destructor ---//
+	NodeArena();
+	~NodeArena();
+
+	//--- Methods ---//
+	void* Allocate(size_t _size, size_t _alignment);
+	void Recycle(void* _memory, size_t _size);
+	void Reset();
+	void Release();
+
+	// Allocate and construct a single object inside the arena. Its destructor is never called so it must not own any other memory
+	template<typename T, typename... Args>
+	T* Create(Args&&... _args)
+	{
+		return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(_args)...);
+	}
+
+	// Allocate an uninitialized array inside the arena
+	template<typename T>
+	T* CreateArray(int _count)
+	{
+		return static_cast<T*>(Allocate(sizeof(T) * _count, alignof(T)));
+	}
+
+	// Put an object or array created above back into the pool so its memory can be reused
+	template<typename T>
+	void Destroy(T* _object)
+	{
+		_object->~T();
+		Recycle(_object, sizeof(T));
+	}
+
+	template<typename T>
+	void DestroyArray(T* _array, int _count)
+	{
+		Recycle(_array, sizeof(T) * _count);
+	}
+
+	//--- Setters and Getters ---//
+	size_t GetBytesUsed() const;
+	size_t GetBytesReserved() const;
+
+private:
+	//--- Data ---//
+	std::vector<char*> blocks;
+	size_t currentBlock;
+	size_t currentOffset;
+	size_t bytesUsed;
+
+	// Recycled allocations, indexed by their size in bytes
+	std::vector<std::vector<void*>> freeLists;
+
+	//--- Static Variables ---//
+	static const size_t BLOCK_SIZE = 64 * 1024;
+	static const size_t INITIAL_BLOCK_CAPACITY = 64;
+};
\ No newline at end of file
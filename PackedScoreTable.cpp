@@ -0,0 +1,123 @@
+#include <cstring>
+#include "PackedScoreTable.h"
+#include "SolvedScoreTable.h"
+
+namespace
+{
+	// The 2 bit codes for each outcome
+	const uint8_t OUTCOME_TIE = 0;
+	const uint8_t OUTCOME_X_WINS = 1;
+	const uint8_t OUTCOME_O_WINS = 2;
+}
+
+
+
+//--- Constructors and Destructor ---//
+PackedScoreTable::PackedScoreTable()
+{
+	std::memset(packedOutcomes, 0, sizeof(packedOutcomes));
+	isBuilt = false;
+}
+
+PackedScoreTable::~PackedScoreTable()
+{
+}
+
+
+
+//--- Methods ---//
+void PackedScoreTable::Build()
+{
+	// Only the sign of each solved score is kept. The distance to the end of the game is thrown away
+	std::memset(packedOutcomes, 0, sizeof(packedOutcomes));
+	for (int i = 0; i < NUM_BOARD_INDICES; i++)
+	{
+		int score = SolvedScoreTable::GetScore(i);
+		uint8_t outcome = (score > 0) ? OUTCOME_X_WINS : (score < 0) ? OUTCOME_O_WINS : OUTCOME_TIE;
+		packedOutcomes[i / 4] |= uint8_t(outcome << ((i % 4) * 2));
+	}
+
+	isBuilt = true;
+}
+
+BoardLocation PackedScoreTable::ChooseMove(const BoardConfiguration& _layout, std::minstd_rand& _random) const
+{
+	// If the game is already over, there is no move to make
+	if (_layout.EvaluateWinner() != ' ')
+		return BoardLocation::Num_Locations;
+
+	// Every move is ranked by the outcome of the layout it leads to, from the mover's perspective, and then by how soon that outcome happens
+	// Without distances in the table, only the very next move can be checked: winning on the spot beats winning later,
+	// and when every move loses, a move that doesn't let the opponent win straight away beats one that does
+	char tileToMove = _layout.GetTileToMove();
+	int perspective = (tileToMove == 'X') ? 1 : -1;
+
+	BoardLocation goodOptions[BoardLocation::Num_Locations];
+	int numGoodOptions = 0;
+	int bestRank = 0;
+	MoveList emptySpaces = _layout.GetEmptySpaces();
+	for (int i = 0; i < emptySpaces.GetSize(); i++)
+	{
+		BoardConfiguration childLayout = _layout;
+		char winner = childLayout.ApplyMove(emptySpaces[i], tileToMove);
+		int outcome = GetOutcome(childLayout) * perspective;
+
+		int rank = outcome * 4;
+		if (winner == tileToMove)
+			rank += 1;
+		else if (outcome < 0 && !CanWinNextMove(childLayout))
+			rank += 1;
+
+		// Reset the good options list if there is a new best rank
+		if (numGoodOptions == 0 || rank > bestRank)
+		{
+			bestRank = rank;
+			numGoodOptions = 0;
+		}
+
+		if (rank == bestRank)
+			goodOptions[numGoodOptions++] = emptySpaces[i];
+	}
+
+	// Randomly select one of the good moves
+	return goodOptions[_random() % numGoodOptions];
+}
+
+int PackedScoreTable::GetOutcome(int _index) const
+{
+	uint8_t outcome = (packedOutcomes[_index / 4] >> ((_index % 4) * 2)) & 0x3;
+	return (outcome == OUTCOME_X_WINS) ? 1 : (outcome == OUTCOME_O_WINS) ? -1 : 0;
+}
+
+int PackedScoreTable::GetOutcome(const BoardConfiguration& _layout) const {
+	return GetOutcome(_layout.GetIndex());
+}
+
+
+
+//--- Setters and Getters ---//
+bool PackedScoreTable::GetIsBuilt() const {
+	return isBuilt;
+}
+
+size_t PackedScoreTable::GetBytesUsed() const {
+	return sizeof(packedOutcomes);
+}
+
+
+
+//--- Utility Functions ---//
+bool PackedScoreTable::CanWinNextMove(const BoardConfiguration& _layout)
+{
+	// Checks if whoever moves next can complete a line with one more tile
+	char tileToMove = _layout.GetTileToMove();
+	MoveList emptySpaces = _layout.GetEmptySpaces();
+	for (int i = 0; i < emptySpaces.GetSize(); i++)
+	{
+		BoardConfiguration childLayout = _layout;
+		if (childLayout.ApplyMove(emptySpaces[i], tileToMove) == tileToMove)
+			return true;
+	}
+
+	return false;
+}
\ No newline at end of file
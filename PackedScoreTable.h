@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include "BoardConfiguration.h"
+
+// The outcome of every layout with perfect play, packed into 2 bits each so the whole game fits in under 5 KB and stays in the L1 cache
+// Only who wins is stored, not how fast, so this is about 8x smaller than a table of full scores
+// Outcomes are from X's perspective, the same as SolvedScoreTable: 1 = X can force a win, -1 = O can force a win, 0 = tie
+class PackedScoreTable
+{
+public:
+	//--- Constructors and Destructor ---//
+	PackedScoreTable();
+	~PackedScoreTable();
+
+	//--- Methods ---//
+	void Build();
+	BoardLocation ChooseMove(const BoardConfiguration& _layout, std::minstd_rand& _random) const;
+	int GetOutcome(int _index) const;
+	int GetOutcome(const BoardConfiguration& _layout) const;
+
+	//--- Setters and Getters ---//
+	bool GetIsBuilt() const;
+	size_t GetBytesUsed() const;
+
+	//--- Static Variables ---//
+	// 4 layouts per byte, rounded up
+	static const int NUM_PACKED_BYTES = (NUM_BOARD_INDICES + 3) / 4;
+
+private:
+	//--- Data ---//
+	// Layout i is stored in bits (i % 4) * 2 of byte i / 4. 0 = tie (or unreachable), 1 = X wins, 2 = O wins
+	uint8_t packedOutcomes[NUM_PACKED_BYTES];
+	bool isBuilt;
+
+	//--- Utility Functions ---//
+	static bool CanWinNextMove(const BoardConfiguration& _layout);
+};
\ No newline at end of file
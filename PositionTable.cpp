@@ -0,0 +1,76 @@
+#include "PositionTable.h"
+
+//--- Constructors and Destructor ---//
+PositionTable::PositionTable()
+{
+	// Allocate a slot for every possible layout up front so the table never has to grow
+	slots = std::unique_ptr<std::atomic<MinMaxNode*>[]>(new std::atomic<MinMaxNode*>[NUM_BOARD_INDICES]);
+	for (int i = 0; i < NUM_BOARD_INDICES; i++)
+		slots[i].store(nullptr, std::memory_order_relaxed);
+
+	numNodes = 0;
+}
+
+PositionTable::~PositionTable()
+{
+	// The nodes themselves are owned and cleaned up by MinMaxTree
+}
+
+
+
+//--- Methods ---//
+MinMaxNode* PositionTable::Find(const BoardConfiguration& _layout) const
+{
+	// Returns nullptr if no node has been stored for this layout yet
+	// Acquire so a node inserted by another thread is fully constructed by the time it is seen here
+	return slots[_layout.GetIndex()].load(std::memory_order_acquire);
+}
+
+bool PositionTable::Insert(const BoardConfiguration& _layout, MinMaxNode* _node)
+{
+	// Same as std::unordered_map::insert, an existing entry is kept and not overwritten
+	return InsertOrFind(_layout, _node) == _node;
+}
+
+MinMaxNode* PositionTable::InsertOrFind(const BoardConfiguration& _layout, MinMaxNode* _node)
+{
+	// Claim the slot if it is still empty. If another thread got there first, their node is returned instead and should be used
+	MinMaxNode* existingNode = nullptr;
+	if (slots[_layout.GetIndex()].compare_exchange_strong(existingNode, _node, std::memory_order_acq_rel, std::memory_order_acquire))
+	{
+		numNodes.fetch_add(1, std::memory_order_relaxed);
+		return _node;
+	}
+
+	return existingNode;
+}
+
+void PositionTable::Remove(const BoardConfiguration& _layout)
+{
+	// Empty the slot so the layout can be inserted again later
+	if (slots[_layout.GetIndex()].exchange(nullptr, std::memory_order_acq_rel) != nullptr)
+		numNodes.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void PositionTable::Clear()
+{
+	// Reset all of the slots so the table can be reused for the next tree
+	if (numNodes > 0)
+	{
+		for (int i = 0; i < NUM_BOARD_INDICES; i++)
+			slots[i].store(nullptr, std::memory_order_relaxed);
+	}
+
+	numNodes = 0;
+}
+
+
+
+//--- Setters and Getters ---//
+MinMaxNode* PositionTable::GetNodeAtIndex(int _index) const {
+	return slots[_index].load(std::memory_order_acquire);
+}
+
+int PositionTable::GetSize() const {
+	return numNodes;
+}
\ No newline at end of file
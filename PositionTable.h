@@ -0,0 +1,34 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include "BoardConfiguration.h"
+
+class MinMaxNode;
+
+// Direct-indexed lookup from a board layout to its node, using the layout's base-3 index as the slot
+// Every possible 3x3 layout has its own slot so there is no hashing, no rehashing, and no collisions
+// The slots are atomic so the table can be shared by the threads of a parallel build with InsertOrFind
+class PositionTable
+{
+public:
+	//--- Constructors and Destructor ---//
+	PositionTable();
+	~PositionTable();
+
+	//--- Methods ---//
+	MinMaxNode* Find(const BoardConfiguration& _layout) const;
+	bool Insert(const BoardConfiguration& _layout, MinMaxNode* _node);
+	MinMaxNode* InsertOrFind(const BoardConfiguration& _layout, MinMaxNode* _node);
+	void Remove(const BoardConfiguration& _layout);
+	void Clear();
+
+	//--- Setters and Getters ---//
+	MinMaxNode* GetNodeAtIndex(int _index) const;
+	int GetSize() const;
+
+private:
+	//--- Data ---//
+	std::unique_ptr<std::atomic<MinMaxNode*>[]> slots;
+	std::atomic<int> numNodes;
+};
\ No newline at end of file
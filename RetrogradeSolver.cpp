@@ -0,0 +1,173 @@
+#include <algorithm>
+#include "RetrogradeSolver.h"
+#include "WorkStealingPool.h"
+
+// How many layouts each task scores
+static const int POSITIONS_PER_TASK = 256;
+
+
+
+//--- Constructors and Destructor ---//
+RetrogradeSolver::RetrogradeSolver()
+{
+	nextPly = -1;
+}
+
+RetrogradeSolver::~RetrogradeSolver()
+{
+}
+
+
+
+//--- Methods ---//
+void RetrogradeSolver::Solve(int _numThreads)
+{
+	// Score every ply, deepest first. With one thread, there is no need for a pool at all
+	Start();
+
+	if (_numThreads > 1)
+	{
+		WorkStealingPool pool(_numThreads);
+		while (SolveNextPly(&pool));
+	}
+	else
+	{
+		while (SolveNextPly(nullptr));
+	}
+}
+
+void RetrogradeSolver::Start()
+{
+	// Forget any earlier solve and list the layouts again, ready to score the last ply first
+	scores.assign(NUM_BOARD_INDICES, 0);
+	EnumeratePositions();
+	nextPly = BoardLocation::Num_Locations;
+}
+
+bool RetrogradeSolver::SolveNextPly(WorkStealingPool* _pool)
+{
+	// Scores one ply and returns true if there are more left, so a caller can spread the solve out and stop between plies
+	if (nextPly < 0)
+		return false;
+
+	int ply = nextPly;
+	int numPositions = int(plies[ply].size());
+	if (_pool == nullptr)
+		ScorePositions(ply, 0, numPositions);
+	else
+	{
+		// Every layout in the ply can be scored independently, so split them into chunks and wait for all of them before the next ply
+		for (int start = 0; start < numPositions; start += POSITIONS_PER_TASK)
+		{
+			int end = std::min(start + POSITIONS_PER_TASK, numPositions);
+			_pool->Submit([this, ply, start, end](int /*_workerIndex*/)
+			{
+				ScorePositions(ply, start, end);
+			});
+		}
+
+		_pool->WaitForAll();
+	}
+
+	nextPly--;
+	return nextPly >= 0;
+}
+
+int RetrogradeSolver::GetScore(int _index) const {
+	return scores[_index];
+}
+
+int RetrogradeSolver::GetScore(const BoardConfiguration& _layout) const {
+	return scores[_layout.GetIndex()];
+}
+
+
+
+//--- Setters and Getters ---//
+bool RetrogradeSolver::GetIsSolved() const {
+	return !scores.empty() && nextPly < 0;
+}
+
+int RetrogradeSolver::GetNumPositions() const
+{
+	int numPositions = 0;
+	for (int ply = 0; ply <= BoardLocation::Num_Locations; ply++)
+		numPositions += int(plies[ply].size());
+
+	return numPositions;
+}
+
+int RetrogradeSolver::GetNumPositionsAtPly(int _ply) const {
+	return int(plies[_ply].size());
+}
+
+
+
+//--- Utility Functions ---//
+void RetrogradeSolver::EnumeratePositions()
+{
+	// Start from the empty board and build each ply from the one before it, so only layouts that can come up in a real game are listed
+	// Finished games aren't continued, and a layout reached by several move orders is only listed once
+	std::vector<bool> isListed = std::vector<bool>(NUM_BOARD_INDICES, false);
+	for (int ply = 0; ply <= BoardLocation::Num_Locations; ply++)
+		plies[ply].clear();
+
+	BoardConfiguration emptyLayout = BoardConfiguration();
+	emptyLayout.Init();
+	plies[0].push_back(emptyLayout);
+	isListed[emptyLayout.GetIndex()] = true;
+
+	for (int ply = 0; ply < BoardLocation::Num_Locations; ply++)
+	{
+		for (int i = 0; i < plies[ply].size(); i++)
+		{
+			const BoardConfiguration& layout = plies[ply][i];
+			if (layout.EvaluateWinner() != ' ')
+				continue;
+
+			MoveList emptySpaces = layout.GetEmptySpaces();
+			for (int j = 0; j < emptySpaces.GetSize(); j++)
+			{
+				BoardConfiguration childLayout = layout;
+				childLayout.ApplyMove(emptySpaces[j], layout.GetTileToMove());
+
+				int childIndex = childLayout.GetIndex();
+				if (!isListed[childIndex])
+				{
+					isListed[childIndex] = true;
+					plies[ply + 1].push_back(childLayout);
+				}
+			}
+		}
+	}
+}
+
+void RetrogradeSolver::ScorePositions(int _ply, int _start, int _end)
+{
+	// Each task writes to a different set of layouts and only reads the ply after this one, which is already finished
+	for (int i = _start; i < _end; i++)
+	{
+		const BoardConfiguration& layout = plies[_ply][i];
+
+		// Finished games are scored directly
+		if (layout.EvaluateWinner() != ' ')
+		{
+			scores[layout.GetIndex()] = int8_t(layout.GetTerminalScore());
+			continue;
+		}
+
+		// Otherwise, X takes the best child score and O takes the worst
+		bool isXToMove = (layout.GetTileToMove() == 'X');
+		int bestScore = (isXToMove) ? -WIN_SCORE_BASE : WIN_SCORE_BASE;
+		MoveList emptySpaces = layout.GetEmptySpaces();
+		for (int j = 0; j < emptySpaces.GetSize(); j++)
+		{
+			BoardConfiguration childLayout = layout;
+			childLayout.ApplyMove(emptySpaces[j], layout.GetTileToMove());
+			int childScore = scores[childLayout.GetIndex()];
+			bestScore = (isXToMove) ? std::max(bestScore, childScore) : std::min(bestScore, childScore);
+		}
+
+		scores[layout.GetIndex()] = int8_t(bestScore);
+	}
+}
\ No newline at end of file
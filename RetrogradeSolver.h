@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "BoardConfiguration.h"
+
+class WorkStealingPool;
+
+// Solves every reachable layout without building any nodes, working backwards from the end of the game
+// The layouts are first listed one ply (number of placed tiles) at a time, then scored from ply 9 back to ply 0
+// Every layout only depends on layouts with one more tile, so each ply is scored as a parallel loop once the ply after it is done
+// Scores are from X's perspective and count how fast the game is won (see WIN_SCORE_BASE), the same as the node tree and SolvedScoreTable
+class RetrogradeSolver
+{
+public:
+	//--- Constructors and Destructor ---//
+	RetrogradeSolver();
+	~RetrogradeSolver();
+
+	//--- Methods ---//
+	void Solve(int _numThreads);
+	void Start();
+	bool SolveNextPly(WorkStealingPool* _pool);
+	int GetScore(int _index) const;
+	int GetScore(const BoardConfiguration& _layout) const;
+
+	//--- Setters and Getters ---//
+	bool GetIsSolved() const;
+	int GetNumPositions() const;
+	int GetNumPositionsAtPly(int _ply) const;
+
+private:
+	//--- Data ---//
+	// One score per layout, indexed by BoardConfiguration::GetIndex(). Unreachable layouts stay 0
+	std::vector<int8_t> scores;
+
+	// Every reachable layout, grouped by how many tiles are placed
+	std::vector<BoardConfiguration> plies[BoardLocation::Num_Locations + 1];
+
+	// The next ply to be scored. -1 once ply 0 is done
+	int nextPly;
+
+	//--- Utility Functions ---//
+	void EnumeratePositions();
+	void ScorePositions(int _ply, int _start, int _end);
+};
\ No newline at end of file
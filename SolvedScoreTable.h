@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "BoardConfiguration.h"
+
+// Compile-time minimax solver for the full 3x3 game
+// NOTE: Solving takes a few hundred thousand constant evaluation steps. GCC handles this by default, but MSVC needs /constexpr:steps and clang needs -fconstexpr-steps raised above their defaults
+namespace SolvedScoreSolver
+{
+	// Marks a layout that hasn't been solved yet. Scores themselves are always within +/-(WIN_SCORE_BASE - 5)
+	constexpr int8_t UNSOLVED_SCORE = 127;
+
+	constexpr std::array<bool, 512> BuildWinTable()
+	{
+		// The 8 possible win states as bitmasks (matched row x3, matched col x3, diagonal x2)
+		const BoardMask winLines[8] = { 0x007, 0x038, 0x1C0, 0x049, 0x092, 0x124, 0x111, 0x054 };
+
+		std::array<bool, 512> table = std::array<bool, 512>();
+		for (int mask = 0; mask < 512; mask++)
+		{
+			for (int line = 0; line < 8; line++)
+			{
+				if ((mask & winLines[line]) == winLines[line])
+					table[mask] = true;
+			}
+		}
+
+		return table;
+	}
+
+	constexpr int8_t SolveLayout(std::array<int8_t, NUM_BOARD_INDICES>& _scores, const std::array<bool, 512>& _winTable, BoardMask _xTiles, BoardMask _oTiles, int _index, int _numPlacedTiles)
+	{
+		// Every layout is only solved once, even though it can be reached from many different move orders
+		if (_scores[_index] != UNSOLVED_SCORE)
+			return _scores[_index];
+
+		// Leaf layouts are scored from X's perspective, same as BoardConfiguration::GetTerminalScore(): the faster the win, the bigger the score
+		int8_t score = 0;
+		if (_winTable[_xTiles])
+			score = int8_t(WIN_SCORE_BASE - _numPlacedTiles);
+		else if (_winTable[_oTiles])
+			score = int8_t(-(WIN_SCORE_BASE - _numPlacedTiles));
+		else if ((_xTiles | _oTiles) != FULL_BOARD_MASK)
+		{
+			// Otherwise, X takes the highest scoring move and O takes the lowest scoring move
+			bool isXToMove = (_numPlacedTiles % 2 == 0);
+			score = int8_t((isXToMove) ? -WIN_SCORE_BASE : WIN_SCORE_BASE);
+
+			int placeValue = 1;
+			for (int i = 0; i < BoardLocation::Num_Locations; i++)
+			{
+				BoardMask bit = BoardMask(1 << i);
+				if (!((_xTiles | _oTiles) & bit))
+				{
+					if (isXToMove)
+					{
+						int8_t childScore = SolveLayout(_scores, _winTable, _xTiles | bit, _oTiles, _index + placeValue, _numPlacedTiles + 1);
+						score = (childScore > score) ? childScore : score;
+					}
+					else
+					{
+						int8_t childScore = SolveLayout(_scores, _winTable, _xTiles, _oTiles | bit, _index + 2 * placeValue, _numPlacedTiles + 1);
+						score = (childScore < score) ? childScore : score;
+					}
+				}
+
+				placeValue *= 3;
+			}
+		}
+
+		_scores[_index] = score;
+		return score;
+	}
+
+	constexpr std::array<int8_t, NUM_BOARD_INDICES> Solve()
+	{
+		std::array<int8_t, NUM_BOARD_INDICES> scores = std::array<int8_t, NUM_BOARD_INDICES>();
+		for (int i = 0; i < NUM_BOARD_INDICES; i++)
+			scores[i] = UNSOLVED_SCORE;
+
+		// Solve every layout that can be reached from the empty board, X moves first
+		SolveLayout(scores, BuildWinTable(), 0, 0, 0, 0);
+
+		// Layouts that can't come up in a real game are left as ties
+		for (int i = 0; i < NUM_BOARD_INDICES; i++)
+		{
+			if (scores[i] == UNSOLVED_SCORE)
+				scores[i] = 0;
+		}
+
+		return scores;
+	}
+}
+
+// The minimax score of every layout, indexed by BoardConfiguration::GetIndex()
+// Scores are from X's perspective: positive = X can force a win, negative = O can force a win, 0 = tie with perfect play
+// The size of a score is WIN_SCORE_BASE minus the number of tiles on the board when the game ends, so it also says how quickly the win comes
+class SolvedScoreTable
+{
+public:
+	//--- Static Methods ---//
+	static int GetScore(int _index) {
+		return SCORES[_index];
+	}
+
+	static int GetScore(const BoardConfiguration& _layout) {
+		return SCORES[_layout.GetIndex()];
+	}
+
+private:
+	//--- Static Variables ---//
+	static constexpr std::array<int8_t, NUM_BOARD_INDICES> SCORES = SolvedScoreSolver::Solve();
+};
\ No newline at end of file
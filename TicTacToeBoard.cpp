@@ -104,11 +104,12 @@ void TicTacToeBoard::BeginGame(bool _isPlayerX)
 
 void TicTacToeBoard::AddTile(BoardLocation _location, char _newTile)
 {
-	// Set the tile at the location accordingly
-	boardLayout.placedTiles[_location] = _newTile;
+	// Set the tile at the location accordingly. This also tells us if the game is over, only checking the lines through the new tile
+	char winner = boardLayout.ApplyMove(_location, _newTile);
 
-	// Now, check if the game is over
-	CheckForGameOver();
+	// If the result is a space, the game is still going. Otherwise, the game is over and we need to show the correct banner
+	if (winner != ' ')
+		GameOver(winner);
 }
 
 void TicTacToeBoard::Draw(Renderer& renderer)
@@ -125,7 +126,7 @@ void TicTacToeBoard::Draw(Renderer& renderer)
 	for (int i = 0; i < BoardLocation::Num_Locations; i++)
 	{
 		// Get the tile type from the internally stored board data
-		char tileType = boardLayout.placedTiles[i];
+		char tileType = boardLayout.GetTile(BoardLocation(i));
 
 		// If the space is empty, just move on
 		if (tileType == '-')
@@ -226,7 +227,7 @@ void TicTacToeBoard::UpdateMouseHover(glm::vec2 _mousePos)
 		if (_mousePos.x >= tileMin.x && _mousePos.x <= tileMax.x && _mousePos.y >= tileMin.y && _mousePos.y <= tileMax.y)
 		{
 			// We are in this tile. But if the tile is occupied, we don't want to show the hover above it
-			hoveredTile = (boardLayout.placedTiles[i] == '-') ? BoardLocation(i) : BoardLocation::Num_Locations;
+			hoveredTile = (boardLayout.GetTile(BoardLocation(i)) == '-') ? BoardLocation(i) : BoardLocation::Num_Locations;
 
 			// Since we found the tile, we can just return and avoid checking the others
 			return;
@@ -276,10 +277,19 @@ void TicTacToeBoard::DEBUG_HandleMouseRightClick()
 
 void TicTacToeBoard::HandleAIMove(BoardConfiguration _newLayout)
 {
-	// Store the new board layout
-	boardLayout = _newLayout;
+	// The AI only ever adds one tile, so find which one it is and add it the same way the player's tiles are added
+	BoardMask placedTiles = (_newLayout.xTiles | _newLayout.oTiles) & ~(boardLayout.xTiles | boardLayout.oTiles);
+	for (int i = 0; i < BoardLocation::Num_Locations; i++)
+	{
+		if (placedTiles == (1 << i))
+		{
+			AddTile(BoardLocation(i), _newLayout.GetTile(BoardLocation(i)));
+			return;
+		}
+	}
 
-	// Check if the game is over now
+	// If the layout didn't change by exactly one tile, just store the new board layout and check if the game is over now
+	boardLayout = _newLayout;
 	CheckForGameOver();
 }
 
@@ -290,6 +300,10 @@ BoardConfiguration TicTacToeBoard::GetCurrentLayout() const {
 	return boardLayout;
 }
 
+BoardLocation TicTacToeBoard::GetHoveredTile() const {
+	return hoveredTile;
+}
+
 bool TicTacToeBoard::GetIsGameOver() const {
 	return isGameOver;
 }
\ No newline at end of file
@@ -29,6 +29,7 @@ public:
 
 	//--- Setters and Getters ---//
 	BoardConfiguration GetCurrentLayout() const;
+	BoardLocation GetHoveredTile() const;
 	bool GetIsGameOver() const;
 
 private:
@@ -0,0 +1,127 @@
+// Counts the heap allocations made while building the node tree and while making moves with it
+// Everything except the node arena's blocks should be allocation free, so the program fails if anything else allocates
+// Build it against the engine source files, as shown under Building The Tools in README.md
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "../MinMaxTree.h"
+
+namespace
+{
+	// Node arena blocks are the only allocations that are expected, and they are all exactly this big
+	const size_t NODE_ARENA_BLOCK_SIZE = 64 * 1024;
+	const int NUM_GAMES = 1000;
+
+	bool isCounting = false;
+	int numBlockAllocations = 0;
+	int numOtherAllocations = 0;
+}
+
+// Replace the global allocation functions so every allocation in the program goes through here
+void* operator new(size_t _size)
+{
+	if (isCounting)
+	{
+		if (_size == NODE_ARENA_BLOCK_SIZE)
+			numBlockAllocations++;
+		else
+			numOtherAllocations++;
+	}
+
+	void* memory = std::malloc(_size == 0 ? 1 : _size);
+	if (memory == nullptr)
+		throw std::bad_alloc();
+
+	return memory;
+}
+
+void* operator new[](size_t _size)
+{
+	return operator new(_size);
+}
+
+void operator delete(void* _memory) noexcept
+{
+	std::free(_memory);
+}
+
+void operator delete[](void* _memory) noexcept
+{
+	std::free(_memory);
+}
+
+void operator delete(void* _memory, size_t) noexcept
+{
+	std::free(_memory);
+}
+
+void operator delete[](void* _memory, size_t) noexcept
+{
+	std::free(_memory);
+}
+
+namespace
+{
+	// Builds the tree and plays a set of games against a random opponent, returning false if anything other than the arena allocated
+	bool CountAllocations(const char* _name, MinMaxTreeSettings _settings)
+	{
+		MinMaxTree tree;
+		tree.SetSettings(_settings);
+		BoardConfiguration emptyLayout = BoardConfiguration();
+		emptyLayout.Init();
+		srand(1);
+
+		// Building the tree
+		numBlockAllocations = 0;
+		numOtherAllocations = 0;
+		isCounting = true;
+		tree.Init(emptyLayout);
+		isCounting = false;
+		int buildBlocks = numBlockAllocations;
+		int buildOther = numOtherAllocations;
+
+		// Playing games. The AI alternates between X and O, and the other side plays randomly
+		numBlockAllocations = 0;
+		numOtherAllocations = 0;
+		isCounting = true;
+		for (int game = 0; game < NUM_GAMES; game++)
+		{
+			bool aiIsX = (game % 2 == 0);
+			BoardConfiguration layout = emptyLayout;
+			tree.Init(layout);
+
+			while (layout.EvaluateWinner() == ' ')
+			{
+				if ((layout.GetTileToMove() == 'X') == aiIsX)
+					layout = tree.DecideNextMove();
+				else
+				{
+					MoveList emptySpaces = layout.GetEmptySpaces();
+					BoardLocation move = emptySpaces[rand() % emptySpaces.GetSize()];
+					layout.ApplyMove(move, layout.GetTileToMove());
+					tree.HandlePlayerMove(move);
+				}
+			}
+		}
+		isCounting = false;
+
+		std::printf("%-12s build: %d arena blocks, %d other allocations   %d games: %d arena blocks, %d other allocations\n",
+			_name, buildBlocks, buildOther, NUM_GAMES, numBlockAllocations, numOtherAllocations);
+
+		return buildOther == 0 && numBlockAllocations == 0 && numOtherAllocations == 0;
+	}
+}
+
+int main()
+{
+	MinMaxTreeSettings settings = MinMaxTreeSettings();
+	settings.backend = Backend_NodeTree;
+	bool succeeded = CountAllocations("Full tree", settings);
+
+	settings.useSymmetry = true;
+	succeeded &= CountAllocations("Symmetry", settings);
+
+	std::printf("%s\n", succeeded ? "PASSED" : "FAILED");
+	return succeeded ? 0 : 1;
+}
\ No newline at end of file
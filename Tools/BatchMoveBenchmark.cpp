@@ -0,0 +1,154 @@
+// Times GameEngine::ChooseMoves on batches of 1 up to 1,000,000 random boards, on the calling thread and spread over a WorkStealingPool
+// Every answer is checked against the engine's own scores: the best move has to lead to the board's score, and so does every move in goodMoves
+// Boards that can't come up in a game are checked to be turned away with INVALID_BOARD_MOVE
+// Build it against the engine source files, as shown under Building The Tools in README.md
+// Pass a thread count on the command line to override the number of hardware threads used by the pool
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../GameEngine.h"
+#include "../WorkStealingPool.h"
+
+namespace
+{
+	const int MAX_BATCH_SIZE = 1000000;
+
+	// Small batches finish too quickly to time once, so each one is repeated until roughly this many boards have been answered
+	const int BOARDS_PER_TIMING = 4000000;
+
+	// Plays random moves from the empty board and stops at a random point, so the boards cover every stage of the game, including finished ones
+	std::vector<BoardConfiguration> MakeRandomLayouts(int _numLayouts)
+	{
+		std::minstd_rand random = std::minstd_rand(1);
+		std::vector<BoardConfiguration> layouts = std::vector<BoardConfiguration>();
+		layouts.reserve(_numLayouts);
+
+		for (int i = 0; i < _numLayouts; i++)
+		{
+			BoardConfiguration layout = BoardConfiguration();
+			layout.Init();
+			int numMoves = int(random() % (BoardLocation::Num_Locations + 1));
+			for (int j = 0; j < numMoves && layout.EvaluateWinner() == ' '; j++)
+			{
+				MoveList emptySpaces = layout.GetEmptySpaces();
+				layout.ApplyMove(emptySpaces[random() % emptySpaces.GetSize()], layout.GetTileToMove());
+			}
+
+			layouts.push_back(layout);
+		}
+
+		return layouts;
+	}
+
+	// Returns how many of the results disagree with the engine's scores
+	int CountWrongResults(const GameEngine& _engine, const std::vector<BoardConfiguration>& _layouts, const std::vector<BatchMoveResult>& _results)
+	{
+		int numWrongResults = 0;
+		for (int i = 0; i < int(_layouts.size()); i++)
+		{
+			const BoardConfiguration& layout = _layouts[i];
+			const BatchMoveResult& result = _results[i];
+			int score = _engine.GetScore(layout);
+			bool isWrong = (result.score != score);
+
+			if (layout.EvaluateWinner() != ' ')
+				isWrong |= (result.bestMove != BoardLocation::Num_Locations || result.goodMoves != 0);
+			else
+			{
+				isWrong |= (result.bestMove >= BoardLocation::Num_Locations || !(result.goodMoves & (1 << result.bestMove)));
+
+				// Every empty space is in goodMoves exactly when it keeps the board's score
+				MoveList emptySpaces = layout.GetEmptySpaces();
+				for (int j = 0; j < emptySpaces.GetSize(); j++)
+				{
+					BoardConfiguration childLayout = layout;
+					childLayout.ApplyMove(emptySpaces[j], layout.GetTileToMove());
+					bool isGoodMove = (_engine.GetScore(childLayout) == score);
+					isWrong |= (isGoodMove != bool(result.goodMoves & (1 << emptySpaces[j])));
+				}
+			}
+
+			if (isWrong)
+				numWrongResults++;
+		}
+
+		return numWrongResults;
+	}
+
+	// Boards that can't come up in a game have to be turned away without reading outside the scores
+	int CountAcceptedInvalidBoards(const GameEngine& _engine)
+	{
+		// X and O both on every tile, X and O on the same tile, three X and no O, X has a line but O moved last, O has a line but X moved last
+		const PackedBoard invalidBoards[] = { 0x01FF01FF, 0x00010001, 0x00000007, 0x00580007, 0x00070058 | 0x100 };
+		const size_t numInvalidBoards = sizeof(invalidBoards) / sizeof(invalidBoards[0]);
+		BatchMoveResult results[numInvalidBoards];
+		_engine.ChooseMoves(invalidBoards, numInvalidBoards, results);
+
+		int numAccepted = 0;
+		for (size_t i = 0; i < numInvalidBoards; i++)
+		{
+			if (results[i].bestMove != INVALID_BOARD_MOVE || results[i].score != 0 || results[i].goodMoves != 0)
+				numAccepted++;
+		}
+
+		return numAccepted;
+	}
+
+	// Answers the first _batchSize boards repeatedly and returns how many boards per second were answered
+	template<typename Board>
+	double TimeBatch(const GameEngine& _engine, const std::vector<Board>& _boards, int _batchSize, std::vector<BatchMoveResult>& _results, WorkStealingPool* _pool)
+	{
+		int numRepeats = std::max(1, BOARDS_PER_TIMING / _batchSize);
+		auto startTime = std::chrono::steady_clock::now();
+		for (int i = 0; i < numRepeats; i++)
+			_engine.ChooseMoves(_boards.data(), size_t(_batchSize), _results.data(), _pool);
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+		return double(numRepeats) * _batchSize / elapsed.count();
+	}
+}
+
+int main(int argc, char** argv)
+{
+	// Every hardware thread is used unless a thread count is given on the command line
+	int numThreads = (argc > 1) ? std::atoi(argv[1]) : int(std::thread::hardware_concurrency());
+	numThreads = std::max(1, numThreads);
+
+	GameEngine engine;
+	engine.Init(EngineSource_Retrograde, numThreads);
+	WorkStealingPool pool = WorkStealingPool(numThreads);
+
+	std::vector<BoardConfiguration> layouts = MakeRandomLayouts(MAX_BATCH_SIZE);
+	std::vector<PackedBoard> packedBoards = std::vector<PackedBoard>(MAX_BATCH_SIZE);
+	for (int i = 0; i < MAX_BATCH_SIZE; i++)
+		packedBoards[i] = BatchClassifier::Pack(layouts[i]);
+
+	// Check both kinds of input, on the calling thread and on the pool, before timing anything
+	std::vector<BatchMoveResult> results = std::vector<BatchMoveResult>(MAX_BATCH_SIZE);
+	int numWrongResults = 0;
+	engine.ChooseMoves(layouts.data(), layouts.size(), results.data());
+	numWrongResults += CountWrongResults(engine, layouts, results);
+	engine.ChooseMoves(packedBoards.data(), packedBoards.size(), results.data(), &pool);
+	numWrongResults += CountWrongResults(engine, layouts, results);
+	int numAcceptedInvalidBoards = CountAcceptedInvalidBoards(engine);
+	numWrongResults += numAcceptedInvalidBoards;
+	std::printf("%d boards checked twice, %d invalid boards accepted, %d wrong results\n\n", MAX_BATCH_SIZE, numAcceptedInvalidBoards, numWrongResults);
+
+	std::printf("%10s %18s %18s %18s\n", "Batch", "Layouts/s", "Packed/s", "Packed/s (pool)");
+	for (int batchSize = 1; batchSize <= MAX_BATCH_SIZE; batchSize *= 10)
+	{
+		double layoutRate = TimeBatch(engine, layouts, batchSize, results, nullptr);
+		double packedRate = TimeBatch(engine, packedBoards, batchSize, results, nullptr);
+		double pooledRate = TimeBatch(engine, packedBoards, batchSize, results, &pool);
+		std::printf("%10d %18.0f %18.0f %18.0f\n", batchSize, layoutRate, packedRate, pooledRate);
+	}
+
+	std::printf("\n%d threads in the pool, results are %d bytes each\n", numThreads, int(sizeof(BatchMoveResult)));
+	std::printf("%s\n", (numWrongResults == 0) ? "PASSED" : "FAILED");
+	return (numWrongResults == 0) ? 0 : 1;
+}
\ No newline at end of file
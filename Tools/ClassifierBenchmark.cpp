@@ -0,0 +1,87 @@
+// Measures how many boards per second each BatchClassifier path can classify, compared to unpacking each board and calling EvaluateWinner()
+// Also checks that every path gives exactly the same result as EvaluateWinner()
+// Build it against the engine source files, as shown under Building The Tools in README.md
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "../BatchClassifier.h"
+
+namespace
+{
+	const size_t NUM_BOARDS = 1 << 24;
+	const int NUM_REPEATS = 5;
+
+	// Prints the throughput of one path and returns how many of its results disagree with the expected ones
+	template<typename Function>
+	size_t Measure(const char* _name, const std::vector<char>& _expectedResults, std::vector<char>& _results, Function _function)
+	{
+		double bestSeconds = 0.0;
+		for (int repeat = 0; repeat < NUM_REPEATS; repeat++)
+		{
+			auto startTime = std::chrono::steady_clock::now();
+			_function();
+			std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+			if (repeat == 0 || elapsed.count() < bestSeconds)
+				bestSeconds = elapsed.count();
+		}
+
+		size_t numMismatches = 0;
+		for (size_t i = 0; i < _results.size(); i++)
+			numMismatches += (_results[i] != _expectedResults[i]);
+
+		std::printf("%-28s %10.1f million boards/second   %zu mismatches\n", _name, double(_results.size()) / bestSeconds / 1e6, numMismatches);
+		return numMismatches;
+	}
+}
+
+int main()
+{
+	// Random layouts from every possible index, so the mix includes wins, ties, games in progress and a few impossible boards
+	std::mt19937 random(1);
+	std::uniform_int_distribution<int> indexDistribution(0, NUM_BOARD_INDICES - 1);
+	std::vector<PackedBoard> boards = std::vector<PackedBoard>(NUM_BOARDS);
+	for (size_t i = 0; i < NUM_BOARDS; i++)
+	{
+		int index = indexDistribution(random);
+		BoardMask xTiles = 0;
+		BoardMask oTiles = 0;
+		for (int location = 0; location < BoardLocation::Num_Locations; location++, index /= 3)
+		{
+			if (index % 3 == 1)
+				xTiles |= BoardMask(1 << location);
+			else if (index % 3 == 2)
+				oTiles |= BoardMask(1 << location);
+		}
+
+		boards[i] = PackedBoard(xTiles) | (PackedBoard(oTiles) << 16);
+	}
+
+	std::vector<char> expectedResults = std::vector<char>(NUM_BOARDS);
+	std::vector<char> results = std::vector<char>(NUM_BOARDS);
+	for (size_t i = 0; i < NUM_BOARDS; i++)
+		expectedResults[i] = BatchClassifier::Unpack(boards[i]).EvaluateWinner();
+
+	std::printf("\n%zu boards, best path on this CPU: %s\n\n", NUM_BOARDS, BatchClassifier::GetPathName(Classifier_Best));
+
+	size_t numMismatches = Measure("EvaluateWinner (one at a time)", expectedResults, results, [&]()
+	{
+		for (size_t i = 0; i < NUM_BOARDS; i++)
+			results[i] = BatchClassifier::Unpack(boards[i]).EvaluateWinner();
+	});
+
+	ClassifierPath paths[3] = { Classifier_Scalar, Classifier_SSE2, Classifier_AVX2 };
+	for (int i = 0; i < 3; i++)
+	{
+		if (paths[i] == Classifier_AVX2 && BatchClassifier::GetBestPath() != Classifier_AVX2)
+			continue;
+
+		numMismatches += Measure(BatchClassifier::GetPathName(paths[i]), expectedResults, results, [&]()
+		{
+			BatchClassifier::ClassifyBoards(boards.data(), results.data(), boards.size(), paths[i]);
+		});
+	}
+
+	return (numMismatches == 0) ? 0 : 1;
+}
\ No newline at end of file
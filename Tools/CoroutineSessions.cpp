@@ -0,0 +1,361 @@
+// Runs tens of thousands of games at once, each one a C++20 coroutine that plays a full game against a random opponent and suspends while it waits for the opponent's move
+// A scheduler resumes whichever sessions have their opponent's move, so one thread can keep every game going without a thread or a stack per game
+// Reports games per second, how much memory each session takes, and the latency of each engine reply (both the time spent deciding and the time since the opponent moved)
+// This is the only part of the project that needs C++20. Build it against the engine source files, as shown under Building The Tools in README.md, with -std=c++20 instead of -std=c++17
+// Usage: CoroutineSessions [sessions] [games per session] [threads]. Each thread gets its own scheduler and its own share of the sessions
+
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../GameEngine.h"
+
+namespace
+{
+	const int DEFAULT_NUM_SESSIONS = 10000;
+	const int DEFAULT_GAMES_PER_SESSION = 20;
+
+	// Every coroutine frame is carved out of fixed-size blocks, so a session's memory doesn't change over its lifetime and games don't hit the general purpose allocator
+	const size_t FRAME_BLOCK_SIZE = 256;
+	const size_t FRAME_BLOCKS_PER_CHUNK = 4096;
+
+	typedef std::chrono::steady_clock Clock;
+
+	// Fixed-size blocks for coroutine frames, reused through a free list. There is one per thread, so no locks are needed
+	class FramePool
+	{
+	public:
+		//--- Methods ---//
+		void* Allocate(size_t _size)
+		{
+			largestFrame = std::max(largestFrame, _size);
+
+			// A frame that doesn't fit still works, it just isn't pooled
+			if (_size > FRAME_BLOCK_SIZE)
+			{
+				numOversizedFrames++;
+				return ::operator new(_size);
+			}
+
+			if (freeBlocks.empty())
+			{
+				chunks.push_back(std::unique_ptr<char[]>(new char[FRAME_BLOCK_SIZE * FRAME_BLOCKS_PER_CHUNK]));
+				for (size_t i = 0; i < FRAME_BLOCKS_PER_CHUNK; i++)
+					freeBlocks.push_back(chunks.back().get() + i * FRAME_BLOCK_SIZE);
+			}
+
+			void* block = freeBlocks.back();
+			freeBlocks.pop_back();
+			return block;
+		}
+
+		void Free(void* _frame, size_t _size)
+		{
+			if (_size > FRAME_BLOCK_SIZE)
+				::operator delete(_frame);
+			else
+				freeBlocks.push_back(_frame);
+		}
+
+		//--- Setters and Getters ---//
+		size_t GetLargestFrame() const { return largestFrame; }
+		size_t GetNumOversizedFrames() const { return numOversizedFrames; }
+
+	private:
+		//--- Data ---//
+		std::vector<std::unique_ptr<char[]>> chunks;
+		std::vector<void*> freeBlocks;
+		size_t largestFrame = 0;
+		size_t numOversizedFrames = 0;
+	};
+
+	thread_local FramePool framePool;
+
+	// One game, played by a coroutine. The scheduler resumes it, and it returns the winning tile once the game is over
+	class GameTask
+	{
+	public:
+		struct promise_type
+		{
+			//--- Methods ---//
+			GameTask get_return_object() { return GameTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			std::suspend_always final_suspend() noexcept { return {}; }
+			void return_value(char _winner) { winner = _winner; }
+			void unhandled_exception() { std::terminate(); }
+
+			static void* operator new(size_t _size) { return framePool.Allocate(_size); }
+			static void operator delete(void* _frame, size_t _size) { framePool.Free(_frame, _size); }
+
+			//--- Data ---//
+			char winner = ' ';
+		};
+
+		//--- Constructors and Destructor ---//
+		GameTask() {}
+		explicit GameTask(std::coroutine_handle<promise_type> _handle) { handle = _handle; }
+		GameTask(GameTask&& _other) noexcept { handle = _other.handle; _other.handle = nullptr; }
+		GameTask& operator=(GameTask&& _other) noexcept
+		{
+			if (this != &_other)
+			{
+				if (handle)
+					handle.destroy();
+				handle = _other.handle;
+				_other.handle = nullptr;
+			}
+			return *this;
+		}
+		~GameTask()
+		{
+			if (handle)
+				handle.destroy();
+		}
+
+		//--- Methods ---//
+		void Resume() { handle.resume(); }
+		bool IsDone() const { return handle.done(); }
+		char GetWinner() const { return handle.promise().winner; }
+
+	private:
+		//--- Data ---//
+		std::coroutine_handle<promise_type> handle = nullptr;
+	};
+
+	class SessionScheduler;
+
+	// Everything one simulated player's connection needs. The coroutine frame holds the rest while a game is in progress
+	struct SessionContext
+	{
+		GameSession session;
+		GameTask task;
+		SessionScheduler* scheduler = nullptr;
+		Clock::time_point opponentMoveTime;		// When the opponent's latest move arrived
+		int gamesLeft = 0;
+		char engineTile = 'X';
+		BoardLocation opponentMove = BoardLocation::Num_Locations;
+	};
+
+	struct SchedulerResults
+	{
+		int numGames = 0;
+		int numLosses = 0;
+		std::vector<float> decideTimes;		// Microseconds from the session resuming to the engine's reply being on the board
+		std::vector<float> replyLatencies;	// Microseconds from the opponent's move arriving to the engine's reply, including time spent waiting to be resumed
+	};
+
+	GameTask PlayGame(SessionContext& _context);
+
+	// Round-robin scheduler: resumes every session that can make progress, then hands out the opponent's moves to every session that is waiting for one
+	class SessionScheduler
+	{
+	public:
+		//--- Constructors and Destructor ---//
+		SessionScheduler(uint32_t _seed)
+		{
+			opponentRandom.seed(_seed);
+		}
+
+		//--- Methods ---//
+		void Run(SessionContext* _sessions, int _numSessions, int _gamesPerSession)
+		{
+			for (int i = 0; i < _numSessions; i++)
+			{
+				_sessions[i].scheduler = this;
+				_sessions[i].gamesLeft = _gamesPerSession;
+				StartGame(_sessions[i]);
+			}
+
+			while (!readySessions.empty() || !waitingSessions.empty())
+			{
+				// Sessions that start a new game while this list is being run go in the next pass
+				runningSessions.swap(readySessions);
+				for (int i = 0; i < int(runningSessions.size()); i++)
+				{
+					SessionContext& context = *runningSessions[i];
+					context.task.Resume();
+					if (context.task.IsDone())
+						FinishGame(context);
+				}
+				runningSessions.clear();
+
+				// The opponents all answer at once, which is the worst case for how long a session waits to be resumed
+				Clock::time_point now = Clock::now();
+				for (int i = 0; i < int(waitingSessions.size()); i++)
+				{
+					SessionContext& context = *waitingSessions[i];
+					MoveList emptySpaces = context.session.GetLayout().GetEmptySpaces();
+					context.opponentMove = emptySpaces[opponentRandom() % emptySpaces.GetSize()];
+					context.opponentMoveTime = now;
+					readySessions.push_back(&context);
+				}
+				waitingSessions.clear();
+			}
+		}
+
+		void WaitForOpponent(SessionContext* _context) { waitingSessions.push_back(_context); }
+
+		void RecordReply(const SessionContext& _context, Clock::time_point _resumeTime)
+		{
+			Clock::time_point replyTime = Clock::now();
+			results.decideTimes.push_back(std::chrono::duration<float, std::micro>(replyTime - _resumeTime).count());
+			results.replyLatencies.push_back(std::chrono::duration<float, std::micro>(replyTime - _context.opponentMoveTime).count());
+		}
+
+		//--- Setters and Getters ---//
+		SchedulerResults& GetResults() { return results; }
+
+	private:
+		//--- Data ---//
+		std::vector<SessionContext*> readySessions;
+		std::vector<SessionContext*> runningSessions;
+		std::vector<SessionContext*> waitingSessions;
+		std::minstd_rand opponentRandom;
+		SchedulerResults results;
+
+		//--- Utility Functions ---//
+		void StartGame(SessionContext& _context)
+		{
+			// The engine alternates between playing X and O from one game to the next
+			_context.engineTile = (_context.gamesLeft % 2 == 0) ? 'X' : 'O';
+			_context.task = PlayGame(_context);
+			readySessions.push_back(&_context);
+		}
+
+		void FinishGame(SessionContext& _context)
+		{
+			char winner = _context.task.GetWinner();
+			results.numGames++;
+			if (winner != '-' && winner != _context.engineTile)
+				results.numLosses++;
+
+			// Frees the finished frame back to the pool before the next game takes one
+			_context.task = GameTask();
+			if (--_context.gamesLeft > 0)
+				StartGame(_context);
+		}
+	};
+
+	// Suspends the game until the scheduler hands it the opponent's move
+	struct OpponentMoveAwaiter
+	{
+		//--- Methods ---//
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<>) { context.scheduler->WaitForOpponent(&context); }
+		BoardLocation await_resume() const { return context.opponentMove; }
+
+		//--- Data ---//
+		SessionContext& context;
+	};
+
+	// The same flow as TicTacToeBoard, minus the rendering: BeginGame(), then moves back and forth, checking for the game being over after each one
+	GameTask PlayGame(SessionContext& _context)
+	{
+		// BeginGame()
+		BoardConfiguration emptyLayout = BoardConfiguration();
+		emptyLayout.Init();
+		_context.session.Init(emptyLayout);
+
+		while (true)
+		{
+			// CheckForGameOver()
+			char winner = _context.session.GetLayout().EvaluateWinner();
+			if (winner != ' ')
+				co_return winner;
+
+			if (_context.session.GetLayout().GetTileToMove() == _context.engineTile)
+			{
+				// The engine's opening move as X doesn't answer anything, so it isn't timed
+				bool isReply = (_context.session.GetLayout().GetNumPlacedTiles() > 0);
+				Clock::time_point resumeTime = Clock::now();
+				_context.session.DecideNextMove();
+				if (isReply)
+					_context.scheduler->RecordReply(_context, resumeTime);
+			}
+			else
+			{
+				BoardLocation move = co_await OpponentMoveAwaiter{ _context };
+				_context.session.HandlePlayerMove(move);
+			}
+		}
+	}
+
+	float GetPercentile(const std::vector<float>& _sortedValues, double _percentile)
+	{
+		if (_sortedValues.empty())
+			return 0.0f;
+
+		size_t index = size_t(_percentile / 100.0 * double(_sortedValues.size() - 1) + 0.5);
+		return _sortedValues[index];
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int numSessions = std::max(1, (argc > 1) ? std::atoi(argv[1]) : DEFAULT_NUM_SESSIONS);
+	int gamesPerSession = std::max(1, (argc > 2) ? std::atoi(argv[2]) : DEFAULT_GAMES_PER_SESSION);
+	int numThreads = std::max(1, (argc > 3) ? std::atoi(argv[3]) : 1);
+	numThreads = std::min(numThreads, numSessions);
+
+	GameEngine engine;
+	engine.Init(EngineSource_SolvedTable);
+
+	// Every session gets its own seed, and all of them read the same engine
+	std::vector<SessionContext> sessions = std::vector<SessionContext>(numSessions);
+	for (int i = 0; i < numSessions; i++)
+		sessions[i].session = GameSession(&engine, uint32_t(i + 1));
+
+	std::vector<SchedulerResults> results = std::vector<SchedulerResults>(numThreads);
+	std::vector<size_t> largestFrames = std::vector<size_t>(numThreads);
+	std::vector<size_t> numOversizedFrames = std::vector<size_t>(numThreads);
+	std::vector<std::thread> threads = std::vector<std::thread>();
+	Clock::time_point startTime = Clock::now();
+	for (int i = 0; i < numThreads; i++)
+	{
+		threads.push_back(std::thread([&, i]()
+		{
+			int start = int(int64_t(numSessions) * i / numThreads);
+			int end = int(int64_t(numSessions) * (i + 1) / numThreads);
+			SessionScheduler scheduler = SessionScheduler(uint32_t(i + 1));
+			scheduler.Run(sessions.data() + start, end - start, gamesPerSession);
+
+			results[i] = std::move(scheduler.GetResults());
+			largestFrames[i] = framePool.GetLargestFrame();
+			numOversizedFrames[i] = framePool.GetNumOversizedFrames();
+		}));
+	}
+
+	for (int i = 0; i < numThreads; i++)
+		threads[i].join();
+	std::chrono::duration<double> elapsed = Clock::now() - startTime;
+
+	SchedulerResults total = SchedulerResults();
+	size_t largestFrame = 0;
+	size_t totalOversizedFrames = 0;
+	for (int i = 0; i < numThreads; i++)
+	{
+		total.numGames += results[i].numGames;
+		total.numLosses += results[i].numLosses;
+		total.decideTimes.insert(total.decideTimes.end(), results[i].decideTimes.begin(), results[i].decideTimes.end());
+		total.replyLatencies.insert(total.replyLatencies.end(), results[i].replyLatencies.begin(), results[i].replyLatencies.end());
+		largestFrame = std::max(largestFrame, largestFrames[i]);
+		totalOversizedFrames += numOversizedFrames[i];
+	}
+	std::sort(total.decideTimes.begin(), total.decideTimes.end());
+	std::sort(total.replyLatencies.begin(), total.replyLatencies.end());
+
+	std::printf("%d sessions on %d thread(s), %d games each\n", numSessions, numThreads, gamesPerSession);
+	std::printf("Per session: %d bytes of state + a %d byte frame (block of %d) while a game is running\n", int(sizeof(SessionContext)), int(largestFrame), int(FRAME_BLOCK_SIZE));
+	std::printf("%d games, %d engine replies in %.3f s = %.0f games/s, %d losses\n", total.numGames, int(total.decideTimes.size()), elapsed.count(), total.numGames / elapsed.count(), total.numLosses);
+	std::printf("Deciding a reply:       p50 %.2f us, p99 %.2f us\n", GetPercentile(total.decideTimes, 50.0), GetPercentile(total.decideTimes, 99.0));
+	std::printf("Opponent move to reply: p50 %.1f us, p99 %.1f us\n", GetPercentile(total.replyLatencies, 50.0), GetPercentile(total.replyLatencies, 99.0));
+
+	bool succeeded = (total.numLosses == 0 && total.numGames == numSessions * gamesPerSession && totalOversizedFrames == 0);
+	std::printf("%s\n", succeeded ? "PASSED" : "FAILED");
+	return succeeded ? 0 : 1;
+}
\ No newline at end of file
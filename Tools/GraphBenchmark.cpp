@@ -0,0 +1,190 @@
+// Compares walking the game graph through the MinMaxNode objects against walking the flat GameGraph arrays
+// Build it against the engine source files, as shown under Building The Tools in README.md
+// On Linux, cache misses are read from the hardware counters. Everywhere else only the times are reported
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "../MinMaxTree.h"
+#include "../GameGraph.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	// How many times each benchmark is repeated so the timings are long enough to measure
+	const int NUM_FULL_WALKS = 20;
+	const int NUM_GAMES = 200000;
+
+	// Counts cache misses between Start() and Stop() if the hardware counters are available
+	class CacheMissCounter
+	{
+	public:
+		CacheMissCounter()
+		{
+			fileDescriptor = -1;
+#ifdef __linux__
+			perf_event_attr attributes;
+			std::memset(&attributes, 0, sizeof(attributes));
+			attributes.type = PERF_TYPE_HARDWARE;
+			attributes.size = sizeof(attributes);
+			attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+			attributes.disabled = 1;
+			attributes.exclude_kernel = 1;
+			attributes.exclude_hv = 1;
+			fileDescriptor = int(syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+		}
+
+		~CacheMissCounter()
+		{
+#ifdef __linux__
+			if (fileDescriptor != -1)
+				close(fileDescriptor);
+#endif
+		}
+
+		void Start()
+		{
+#ifdef __linux__
+			if (fileDescriptor != -1)
+			{
+				ioctl(fileDescriptor, PERF_EVENT_IOC_RESET, 0);
+				ioctl(fileDescriptor, PERF_EVENT_IOC_ENABLE, 0);
+			}
+#endif
+		}
+
+		// Returns -1 if the counters aren't available
+		long long Stop()
+		{
+			long long count = -1;
+#ifdef __linux__
+			if (fileDescriptor != -1)
+			{
+				ioctl(fileDescriptor, PERF_EVENT_IOC_DISABLE, 0);
+				if (read(fileDescriptor, &count, sizeof(count)) != sizeof(count))
+					count = -1;
+			}
+#endif
+			return count;
+		}
+
+	private:
+		int fileDescriptor;
+	};
+
+	// Visits every path through the graph, which touches each node once per way of reaching it (about 550k visits from the empty board)
+	long long WalkNodes(const MinMaxNode* _node)
+	{
+		long long total = _node->GetNodeScore();
+		for (int i = 0; i < _node->GetNumChildren(); i++)
+			total += WalkNodes(_node->GetChild(i));
+
+		return total;
+	}
+
+	long long WalkGraph(const GameGraph& _graph, int _nodeIndex)
+	{
+		const GraphNode& node = _graph.GetNode(_nodeIndex);
+		long long total = node.score;
+		for (uint32_t i = node.firstEdge; i < node.firstEdge + node.numEdges; i++)
+			total += WalkGraph(_graph, int(_graph.GetEdge(i).childNode));
+
+		return total;
+	}
+
+	// Plays a game where both sides pick the best child, the same work MakeDecision does on every move
+	long long PlayNodes(const MinMaxNode* _node)
+	{
+		long long total = 0;
+		while (_node->GetNumChildren() > 0)
+		{
+			bool isXToMove = _node->GetBoardLayout().GetTileToMove() == 'X';
+			const MinMaxNode* bestChild = _node->GetChild(0);
+			for (int i = 1; i < _node->GetNumChildren(); i++)
+			{
+				const MinMaxNode* child = _node->GetChild(i);
+				if ((isXToMove && child->GetNodeScore() > bestChild->GetNodeScore()) || (!isXToMove && child->GetNodeScore() < bestChild->GetNodeScore()) ||
+					(child->GetNodeScore() == bestChild->GetNodeScore() && rand() % 2 == 0))
+					bestChild = child;
+			}
+
+			total += bestChild->GetNodeScore();
+			_node = bestChild;
+		}
+
+		return total;
+	}
+
+	long long PlayGraph(const GameGraph& _graph, int _nodeIndex)
+	{
+		long long total = 0;
+		while (_graph.GetNode(_nodeIndex).numEdges > 0)
+		{
+			const GraphNode& node = _graph.GetNode(_nodeIndex);
+			bool isXToMove = (node.flags & GraphNode_XToMove) != 0;
+			int bestChild = int(_graph.GetEdge(node.firstEdge).childNode);
+			for (uint32_t i = node.firstEdge + 1; i < node.firstEdge + node.numEdges; i++)
+			{
+				int child = int(_graph.GetEdge(i).childNode);
+				int childScore = _graph.GetNode(child).score;
+				int bestScore = _graph.GetNode(bestChild).score;
+				if ((isXToMove && childScore > bestScore) || (!isXToMove && childScore < bestScore) || (childScore == bestScore && rand() % 2 == 0))
+					bestChild = child;
+			}
+
+			total += _graph.GetNode(bestChild).score;
+			_nodeIndex = bestChild;
+		}
+
+		return total;
+	}
+
+	// Times a benchmark and prints its time and cache misses
+	template<typename Function>
+	void Measure(const char* _name, Function _function)
+	{
+		CacheMissCounter counter;
+		srand(1);
+		counter.Start();
+		auto startTime = std::chrono::steady_clock::now();
+		long long result = _function();
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+		long long cacheMisses = counter.Stop();
+
+		if (cacheMisses >= 0)
+			std::printf("%-24s %10.2f ms %14lld cache misses   (checksum %lld)\n", _name, elapsed.count(), cacheMisses, result);
+		else
+			std::printf("%-24s %10.2f ms %14s cache misses   (checksum %lld)\n", _name, elapsed.count(), "n/a", result);
+	}
+}
+
+int main()
+{
+	// Build the node tree, then flatten it into the graph
+	MinMaxTree tree;
+	BoardConfiguration emptyLayout = BoardConfiguration();
+	emptyLayout.Init();
+	tree.Init(emptyLayout);
+
+	GameGraph graph;
+	graph.BuildFromTable(tree.nodeTable, emptyLayout);
+	const MinMaxNode* rootNode = tree.nodeTable.Find(emptyLayout);
+
+	std::printf("\nNode tree:  %d nodes, %zu bytes\n", tree.nodeTable.GetSize(), tree.nodeArena.GetBytesUsed());
+	std::printf("Flat graph: %d nodes, %d edges, %zu bytes\n\n", graph.GetNumNodes(), graph.GetNumEdges(), graph.GetBytesUsed());
+
+	Measure("Full walk (nodes)", [&]() { long long total = 0; for (int i = 0; i < NUM_FULL_WALKS; i++) total += WalkNodes(rootNode); return total; });
+	Measure("Full walk (graph)", [&]() { long long total = 0; for (int i = 0; i < NUM_FULL_WALKS; i++) total += WalkGraph(graph, graph.GetRootNode()); return total; });
+	Measure("Best-move games (nodes)", [&]() { long long total = 0; for (int i = 0; i < NUM_GAMES; i++) total += PlayNodes(rootNode); return total; });
+	Measure("Best-move games (graph)", [&]() { long long total = 0; for (int i = 0; i < NUM_GAMES; i++) total += PlayGraph(graph, graph.GetRootNode()); return total; });
+
+	return 0;
+}
\ No newline at end of file
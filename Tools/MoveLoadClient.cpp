@@ -0,0 +1,266 @@
+// Load generator for Tools/MoveServer.cpp. Opens several connections to the server's socket and keeps a fixed number of boards in flight on each one
+// Reports requests per second and the p50/p99 latency from sending a board to reading its answer, and checks every answer against a local GameEngine
+// Linux only. Build it against the engine source files, as shown under Building The Tools in README.md
+// Usage: MoveLoadClient [socket path] [connections] [boards in flight per connection] [seconds]
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../GameEngine.h"
+
+namespace
+{
+	const char* DEFAULT_SOCKET_PATH = "/tmp/tictactoe.sock";
+	const int DEFAULT_NUM_CONNECTIONS = 8;
+	const int DEFAULT_PIPELINE_DEPTH = 16;
+	const int DEFAULT_SECONDS = 5;
+
+	// The boards are picked from a fixed set, so the expected answers can be worked out once up front
+	const int NUM_BOARDS = 4096;
+
+	// Boards the server has to turn away: a line made by the player who didn't move last, both players with a line, and uneven tile counts
+	const char* INVALID_BOARDS[] = { "XXXOO-O--", "XXXOOO---", "OOOXX-X-X", "OOOXX----", "XX-------", "O--------" };
+
+	typedef std::chrono::steady_clock Clock;
+
+	struct Request
+	{
+		std::string line;		// The board as it is sent, including the newline
+		std::string answer;		// What the server should send back, including the newline
+	};
+
+	struct ConnectionResults
+	{
+		std::vector<double> latencies;	// In microseconds, one per answered request
+		long long numWrongAnswers = 0;
+		bool failed = false;
+	};
+
+	// Random boards from every stage of the game, including finished ones, with the answers the server should give for them, plus a few invalid ones
+	std::vector<Request> MakeRequests(const GameEngine& _engine)
+	{
+		std::minstd_rand random = std::minstd_rand(1);
+		std::vector<PackedBoard> boards = std::vector<PackedBoard>();
+		std::vector<Request> requests = std::vector<Request>();
+
+		for (int i = 0; i < NUM_BOARDS; i++)
+		{
+			BoardConfiguration layout = BoardConfiguration();
+			layout.Init();
+			int numMoves = int(random() % (BoardLocation::Num_Locations + 1));
+			for (int j = 0; j < numMoves && layout.EvaluateWinner() == ' '; j++)
+			{
+				MoveList emptySpaces = layout.GetEmptySpaces();
+				layout.ApplyMove(emptySpaces[random() % emptySpaces.GetSize()], layout.GetTileToMove());
+			}
+
+			Request request = Request();
+			for (int j = 0; j < BoardLocation::Num_Locations; j++)
+				request.line += layout.GetTile(BoardLocation(j));
+			request.line += '\n';
+
+			boards.push_back(BatchClassifier::Pack(layout));
+			requests.push_back(request);
+		}
+
+		// The server answers with GameEngine::ChooseMoves() too, which always picks the same move for the same board
+		std::vector<BatchMoveResult> results = std::vector<BatchMoveResult>(boards.size());
+		_engine.ChooseMoves(boards.data(), boards.size(), results.data());
+		for (int i = 0; i < NUM_BOARDS; i++)
+		{
+			int move = (results[i].bestMove == BoardLocation::Num_Locations) ? -1 : int(results[i].bestMove);
+			requests[i].answer = std::to_string(move) + " " + std::to_string(int(results[i].score)) + "\n";
+		}
+
+		for (const char* invalidBoard : INVALID_BOARDS)
+			requests.push_back({ std::string(invalidBoard) + "\n", "error\n" });
+
+		return requests;
+	}
+
+	int Connect(const char* _path)
+	{
+		sockaddr_un address = sockaddr_un();
+		address.sun_family = AF_UNIX;
+		std::strncpy(address.sun_path, _path, sizeof(address.sun_path) - 1);
+
+		int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+		{
+			close(fd);
+			fd = -1;
+		}
+
+		return fd;
+	}
+
+	bool WriteAll(int _fd, const std::string& _data)
+	{
+		size_t numWritten = 0;
+		while (numWritten < _data.size())
+		{
+			ssize_t result = write(_fd, _data.data() + numWritten, _data.size() - numWritten);
+			if (result < 0 && errno == EINTR)
+				continue;
+			if (result <= 0)
+				return false;
+			numWritten += size_t(result);
+		}
+
+		return true;
+	}
+
+	// Keeps _pipelineDepth boards in flight until the time is up. Each answer that comes back is replaced by a new board,
+	// and all of the replacements from one read go out in a single write, the same way a real client would pipeline
+	void RunConnection(const char* _path, const std::vector<Request>& _requests, int _connectionIndex, int _pipelineDepth, Clock::time_point _endTime, ConnectionResults& _outResults)
+	{
+		int fd = Connect(_path);
+		if (fd < 0)
+		{
+			_outResults.failed = true;
+			return;
+		}
+
+		std::minstd_rand random = std::minstd_rand(uint32_t(_connectionIndex + 1));
+
+		// Answers come back in order, so the requests in flight are a queue. It never holds more than _pipelineDepth, so a ring buffer does
+		std::vector<int> inFlightRequests = std::vector<int>(_pipelineDepth);
+		std::vector<Clock::time_point> sendTimes = std::vector<Clock::time_point>(_pipelineDepth);
+		int queueFront = 0;
+		int numInFlight = 0;
+
+		std::string outgoing = std::string();
+		std::string incoming = std::string();
+		char readBuffer[4096];
+		int numToSend = _pipelineDepth;
+
+		while (true)
+		{
+			// Top the pipeline back up, unless the time is up, in which case just wait for what is still in flight
+			Clock::time_point now = Clock::now();
+			if (now >= _endTime)
+				numToSend = 0;
+
+			outgoing.clear();
+			for (int i = 0; i < numToSend; i++)
+			{
+				int requestIndex = int(random() % _requests.size());
+				int slot = (queueFront + numInFlight) % _pipelineDepth;
+				inFlightRequests[slot] = requestIndex;
+				sendTimes[slot] = now;
+				numInFlight++;
+				outgoing += _requests[requestIndex].line;
+			}
+
+			if (!outgoing.empty() && !WriteAll(fd, outgoing))
+			{
+				_outResults.failed = true;
+				break;
+			}
+
+			if (numInFlight == 0)
+				break;
+
+			ssize_t numRead = read(fd, readBuffer, sizeof(readBuffer));
+			if (numRead < 0 && errno == EINTR)
+				continue;
+			if (numRead <= 0)
+			{
+				_outResults.failed = true;
+				break;
+			}
+
+			// Match every complete answer to the oldest request in flight
+			Clock::time_point readTime = Clock::now();
+			incoming.append(readBuffer, size_t(numRead));
+			numToSend = 0;
+			size_t lineStart = 0;
+			size_t lineEnd = incoming.find('\n');
+			while (lineEnd != std::string::npos && numInFlight > 0)
+			{
+				const Request& request = _requests[inFlightRequests[queueFront]];
+				std::chrono::duration<double, std::micro> latency = readTime - sendTimes[queueFront];
+				_outResults.latencies.push_back(latency.count());
+				if (incoming.compare(lineStart, lineEnd + 1 - lineStart, request.answer) != 0)
+					_outResults.numWrongAnswers++;
+
+				queueFront = (queueFront + 1) % _pipelineDepth;
+				numInFlight--;
+				numToSend++;
+
+				lineStart = lineEnd + 1;
+				lineEnd = incoming.find('\n', lineStart);
+			}
+
+			incoming.erase(0, lineStart);
+		}
+
+		close(fd);
+	}
+
+	double GetPercentile(const std::vector<double>& _sortedValues, double _percentile)
+	{
+		if (_sortedValues.empty())
+			return 0.0;
+
+		size_t index = size_t(_percentile / 100.0 * double(_sortedValues.size() - 1) + 0.5);
+		return _sortedValues[index];
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::signal(SIGPIPE, SIG_IGN);
+
+	const char* socketPath = (argc > 1) ? argv[1] : DEFAULT_SOCKET_PATH;
+	int numConnections = std::max(1, (argc > 2) ? std::atoi(argv[2]) : DEFAULT_NUM_CONNECTIONS);
+	int pipelineDepth = std::max(1, (argc > 3) ? std::atoi(argv[3]) : DEFAULT_PIPELINE_DEPTH);
+	int numSeconds = std::max(1, (argc > 4) ? std::atoi(argv[4]) : DEFAULT_SECONDS);
+
+	GameEngine engine;
+	engine.Init(EngineSource_SolvedTable);
+	std::vector<Request> requests = MakeRequests(engine);
+
+	// One thread per connection, each blocking on its own socket
+	std::vector<ConnectionResults> results = std::vector<ConnectionResults>(numConnections);
+	std::vector<std::thread> threads = std::vector<std::thread>();
+	Clock::time_point startTime = Clock::now();
+	Clock::time_point endTime = startTime + std::chrono::seconds(numSeconds);
+	for (int i = 0; i < numConnections; i++)
+		threads.push_back(std::thread(RunConnection, socketPath, std::cref(requests), i, pipelineDepth, endTime, std::ref(results[i])));
+
+	for (int i = 0; i < numConnections; i++)
+		threads[i].join();
+	std::chrono::duration<double> elapsed = Clock::now() - startTime;
+
+	std::vector<double> latencies = std::vector<double>();
+	long long numWrongAnswers = 0;
+	int numFailedConnections = 0;
+	for (int i = 0; i < numConnections; i++)
+	{
+		latencies.insert(latencies.end(), results[i].latencies.begin(), results[i].latencies.end());
+		numWrongAnswers += results[i].numWrongAnswers;
+		numFailedConnections += results[i].failed ? 1 : 0;
+	}
+	std::sort(latencies.begin(), latencies.end());
+
+	std::printf("%d connections, %d boards in flight each, %.2f s\n", numConnections, pipelineDepth, elapsed.count());
+	std::printf("%lld requests = %.0f requests/s\n", (long long)latencies.size(), latencies.size() / elapsed.count());
+	std::printf("Latency: p50 %.1f us, p99 %.1f us, max %.1f us\n", GetPercentile(latencies, 50.0), GetPercentile(latencies, 99.0), latencies.empty() ? 0.0 : latencies.back());
+	std::printf("%lld wrong answers, %d failed connections\n", numWrongAnswers, numFailedConnections);
+
+	bool succeeded = (numWrongAnswers == 0 && numFailedConnections == 0 && !latencies.empty());
+	std::printf("%s\n", succeeded ? "PASSED" : "FAILED");
+	return succeeded ? 0 : 1;
+}
\ No newline at end of file
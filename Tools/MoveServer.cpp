@@ -0,0 +1,353 @@
+// Serves best moves from one shared GameEngine over a Unix domain socket (or stdin/stdout), with no renderer, GL or ImGui linked in
+// The protocol is one board per line, 9 characters of X, O or - in BoardLocation order, ex: "XO--X----\n"
+// Each board is answered with "<best move> <score>\n", where the move is a BoardLocation (-1 if the game is already over) and the score is from X's perspective
+// Boards that can't happen in a real game are answered with "error\n". Answers always come back in the order the boards were sent
+// Clients can send many boards without waiting for the answers. Every board that has arrived on any connection is answered in one GameEngine::ChooseMoves() call
+// Linux only, since it uses epoll. Build it against the engine source files, as shown under Building The Tools in README.md
+// Run it with a socket path (default /tmp/tictactoe.sock), or with --stdio to answer boards from stdin on stdout. Tools/MoveLoadClient.cpp drives it
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../GameEngine.h"
+
+namespace
+{
+	const char* DEFAULT_SOCKET_PATH = "/tmp/tictactoe.sock";
+
+	// A board is 9 characters, so anything much longer than that without a newline is not a board and the connection is dropped
+	const size_t MAX_LINE_LENGTH = 64;
+
+	// A client that keeps sending without reading its answers stops being read from once this many bytes of answers are waiting for it
+	const size_t MAX_PENDING_OUTPUT = 1 << 20;
+
+	const int MAX_EVENTS = 256;
+	const size_t READ_CHUNK_SIZE = 64 * 1024;
+
+	volatile std::sig_atomic_t isStopping = 0;
+
+	void HandleStopSignal(int)
+	{
+		isStopping = 1;
+	}
+
+	struct Connection
+	{
+		int fd = -1;
+		std::string input;		// Bytes read that don't make up a full line yet
+		std::string output;		// Answers that haven't been written yet
+		uint32_t events = EPOLLIN;	// What the connection is currently registered with epoll for
+		bool isClosing = false;
+	};
+
+	// One board from one connection, in the order they arrived
+	struct PendingRequest
+	{
+		Connection* connection;
+		bool isValid;
+	};
+
+	// Turns a line into a packed board, or returns false if it isn't a board that can come up in a game
+	bool ParseBoard(const char* _line, size_t _length, PackedBoard& _outBoard)
+	{
+		// Windows line endings are fine too
+		if (_length > 0 && _line[_length - 1] == '\r')
+			_length--;
+
+		if (_length != BoardLocation::Num_Locations)
+			return false;
+
+		BoardMask xTiles = 0;
+		BoardMask oTiles = 0;
+		for (int i = 0; i < BoardLocation::Num_Locations; i++)
+		{
+			if (_line[i] == 'X' || _line[i] == 'x')
+				xTiles |= BoardMask(1 << i);
+			else if (_line[i] == 'O' || _line[i] == 'o')
+				oTiles |= BoardMask(1 << i);
+			else if (_line[i] != '-')
+				return false;
+		}
+
+		// Boards that can't come up in a game are turned away, ex: O having as many tiles as X after X already made a line
+		if (!BoardConfiguration::IsReachable(xTiles, oTiles))
+			return false;
+
+		BoardConfiguration layout = BoardConfiguration();
+		layout.SetTiles(xTiles, oTiles);
+		_outBoard = BatchClassifier::Pack(layout);
+		return true;
+	}
+
+	// Pulls every complete line out of a connection's input and adds it to the batch
+	void CollectRequests(Connection& _connection, std::vector<PackedBoard>& _boards, std::vector<PendingRequest>& _requests)
+	{
+		size_t lineStart = 0;
+		size_t lineEnd = _connection.input.find('\n');
+		while (lineEnd != std::string::npos)
+		{
+			PackedBoard board = 0;
+			bool isValid = ParseBoard(_connection.input.data() + lineStart, lineEnd - lineStart, board);
+			_boards.push_back(board);
+			_requests.push_back({ &_connection, isValid });
+
+			lineStart = lineEnd + 1;
+			lineEnd = _connection.input.find('\n', lineStart);
+		}
+
+		_connection.input.erase(0, lineStart);
+		if (_connection.input.size() > MAX_LINE_LENGTH)
+			_connection.isClosing = true;
+	}
+
+	// Answers every board in the batch with one call into the engine, and queues each answer on the connection it came from
+	void AnswerRequests(const GameEngine& _engine, const std::vector<PackedBoard>& _boards, const std::vector<PendingRequest>& _requests, std::vector<BatchMoveResult>& _results)
+	{
+		_results.resize(_boards.size());
+		_engine.ChooseMoves(_boards.data(), _boards.size(), _results.data());
+
+		char answer[32];
+		for (size_t i = 0; i < _requests.size(); i++)
+		{
+			if (!_requests[i].isValid)
+			{
+				_requests[i].connection->output += "error\n";
+				continue;
+			}
+
+			int move = (_results[i].bestMove == BoardLocation::Num_Locations) ? -1 : int(_results[i].bestMove);
+			int length = std::snprintf(answer, sizeof(answer), "%d %d\n", move, int(_results[i].score));
+			_requests[i].connection->output.append(answer, size_t(length));
+		}
+	}
+
+	// Writes as much of the pending output as the socket will take. Returns false if the connection has failed
+	bool FlushOutput(Connection& _connection)
+	{
+		while (!_connection.output.empty())
+		{
+			ssize_t numWritten = write(_connection.fd, _connection.output.data(), _connection.output.size());
+			if (numWritten < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				return (errno == EAGAIN || errno == EWOULDBLOCK);
+			}
+
+			_connection.output.erase(0, size_t(numWritten));
+		}
+
+		return true;
+	}
+
+	// Only asks for writable events while there is output waiting, and stops reading from clients that have too much waiting
+	void UpdateEvents(int _epollFd, Connection& _connection)
+	{
+		uint32_t events = 0;
+		if (_connection.output.size() < MAX_PENDING_OUTPUT)
+			events |= EPOLLIN;
+		if (!_connection.output.empty())
+			events |= EPOLLOUT;
+
+		if (events == _connection.events)
+			return;
+
+		epoll_event event = epoll_event();
+		event.events = events;
+		event.data.ptr = &_connection;
+		epoll_ctl(_epollFd, EPOLL_CTL_MOD, _connection.fd, &event);
+		_connection.events = events;
+	}
+
+	int OpenListenSocket(const char* _path)
+	{
+		sockaddr_un address = sockaddr_un();
+		address.sun_family = AF_UNIX;
+		if (std::strlen(_path) >= sizeof(address.sun_path))
+		{
+			std::fprintf(stderr, "Socket path is too long: %s\n", _path);
+			return -1;
+		}
+		std::strcpy(address.sun_path, _path);
+
+		// A socket file left behind by a server that didn't shut down cleanly would make bind() fail
+		unlink(_path);
+
+		int listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+		if (listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listenFd, SOMAXCONN) < 0)
+		{
+			std::perror("Failed to open the socket");
+			if (listenFd >= 0)
+				close(listenFd);
+			return -1;
+		}
+
+		return listenFd;
+	}
+
+	int RunSocketServer(const GameEngine& _engine, const char* _path)
+	{
+		int listenFd = OpenListenSocket(_path);
+		if (listenFd < 0)
+			return 1;
+
+		int epollFd = epoll_create1(EPOLL_CLOEXEC);
+		epoll_event listenEvent = epoll_event();
+		listenEvent.events = EPOLLIN;
+		listenEvent.data.ptr = nullptr;
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &listenEvent);
+		std::printf("Serving best moves on %s\n", _path);
+		std::fflush(stdout);
+
+		// Connections are owned here and looked up by the pointer stored in each epoll event
+		std::unordered_map<Connection*, std::unique_ptr<Connection>> connections = std::unordered_map<Connection*, std::unique_ptr<Connection>>();
+		std::vector<epoll_event> events = std::vector<epoll_event>(MAX_EVENTS);
+		std::vector<char> readBuffer = std::vector<char>(READ_CHUNK_SIZE);
+		std::vector<PackedBoard> boards = std::vector<PackedBoard>();
+		std::vector<PendingRequest> requests = std::vector<PendingRequest>();
+		std::vector<BatchMoveResult> results = std::vector<BatchMoveResult>();
+		std::vector<Connection*> touchedConnections = std::vector<Connection*>();
+
+		while (!isStopping)
+		{
+			int numEvents = epoll_wait(epollFd, events.data(), MAX_EVENTS, -1);
+			if (numEvents < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				std::perror("epoll_wait failed");
+				break;
+			}
+
+			// Read everything that has arrived on every ready connection first, so all of it can be answered in a single batch
+			boards.clear();
+			requests.clear();
+			touchedConnections.clear();
+			for (int i = 0; i < numEvents; i++)
+			{
+				Connection* connection = static_cast<Connection*>(events[i].data.ptr);
+				if (connection == nullptr)
+				{
+					// Accept every client that is waiting
+					int clientFd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+					while (clientFd >= 0)
+					{
+						std::unique_ptr<Connection> newConnection = std::unique_ptr<Connection>(new Connection());
+						newConnection->fd = clientFd;
+
+						epoll_event clientEvent = epoll_event();
+						clientEvent.events = EPOLLIN;
+						clientEvent.data.ptr = newConnection.get();
+						epoll_ctl(epollFd, EPOLL_CTL_ADD, clientFd, &clientEvent);
+						connections[newConnection.get()] = std::move(newConnection);
+
+						clientFd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+					}
+					continue;
+				}
+
+				touchedConnections.push_back(connection);
+				if (events[i].events & (EPOLLERR | EPOLLHUP))
+					connection->isClosing = true;
+
+				if (events[i].events & EPOLLIN)
+				{
+					// Level triggered, so anything left unread just shows up again on the next wait
+					ssize_t numRead = read(connection->fd, readBuffer.data(), readBuffer.size());
+					if (numRead > 0)
+					{
+						connection->input.append(readBuffer.data(), size_t(numRead));
+						CollectRequests(*connection, boards, requests);
+					}
+					else if (numRead == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+						connection->isClosing = true;
+				}
+			}
+
+			if (!boards.empty())
+				AnswerRequests(_engine, boards, requests, results);
+
+			// Send the answers, and drop connections that have closed or failed. A client that hung up after sending still gets what can be written
+			for (size_t i = 0; i < touchedConnections.size(); i++)
+			{
+				Connection* connection = touchedConnections[i];
+				bool isHealthy = FlushOutput(*connection);
+				if (!isHealthy || connection->isClosing)
+				{
+					epoll_ctl(epollFd, EPOLL_CTL_DEL, connection->fd, nullptr);
+					close(connection->fd);
+					connections.erase(connection);
+				}
+				else
+					UpdateEvents(epollFd, *connection);
+			}
+		}
+
+		for (auto& connection : connections)
+			close(connection.second->fd);
+		close(epollFd);
+		close(listenFd);
+		unlink(_path);
+		std::printf("Stopped\n");
+		return 0;
+	}
+
+	// stdin can be a file or a pipe, which epoll can't always watch, so this just reads in blocks and answers each block as one batch
+	int RunStdioServer(const GameEngine& _engine)
+	{
+		Connection connection = Connection();
+		connection.fd = STDOUT_FILENO;
+		std::vector<char> readBuffer = std::vector<char>(READ_CHUNK_SIZE);
+		std::vector<PackedBoard> boards = std::vector<PackedBoard>();
+		std::vector<PendingRequest> requests = std::vector<PendingRequest>();
+		std::vector<BatchMoveResult> results = std::vector<BatchMoveResult>();
+
+		while (!isStopping)
+		{
+			ssize_t numRead = read(STDIN_FILENO, readBuffer.data(), readBuffer.size());
+			if (numRead < 0 && errno == EINTR)
+				continue;
+			if (numRead <= 0)
+				break;
+
+			boards.clear();
+			requests.clear();
+			connection.input.append(readBuffer.data(), size_t(numRead));
+			CollectRequests(connection, boards, requests);
+			if (connection.isClosing)
+				break;
+
+			if (!boards.empty())
+				AnswerRequests(_engine, boards, requests, results);
+			if (!FlushOutput(connection))
+				break;
+		}
+
+		return 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::signal(SIGPIPE, SIG_IGN);
+	std::signal(SIGINT, HandleStopSignal);
+	std::signal(SIGTERM, HandleStopSignal);
+
+	// The compile-time table is ready instantly, and every connection reads the same engine
+	GameEngine engine;
+	engine.Init(EngineSource_SolvedTable);
+
+	if (argc > 1 && std::strcmp(argv[1], "--stdio") == 0)
+		return RunStdioServer(engine);
+
+	return RunSocketServer(engine, (argc > 1) ? argv[1] : DEFAULT_SOCKET_PATH);
+}
\ No newline at end of file
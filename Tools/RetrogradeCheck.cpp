@@ -0,0 +1,63 @@
+// Solves the game with RetrogradeSolver on one thread and on several, and checks every layout index against a fully built MinMaxTree and SolvedScoreTable
+// The retrograde solver is a different algorithm from the other two, so all three have to agree exactly for its scores to be trusted
+// Build it against the engine source files, as shown under Building The Tools in README.md
+// Pass a thread count on the command line to override the number of hardware threads used for the parallel solve
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include "../MinMaxTree.h"
+#include "../RetrogradeSolver.h"
+#include "../SolvedScoreTable.h"
+
+namespace
+{
+	// Solves on _numThreads threads and counts every index where the solver disagrees with the tree or the compile-time table
+	// The tree only has nodes for layouts that can come up in a game, so it is also checked that the solver found the same number of them
+	bool CheckSolve(const MinMaxTree& _tree, int _numThreads)
+	{
+		auto startTime = std::chrono::steady_clock::now();
+		RetrogradeSolver solver = RetrogradeSolver();
+		solver.Solve(_numThreads);
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+
+		int numTreeMismatches = 0;
+		int numTableMismatches = 0;
+		for (int i = 0; i < NUM_BOARD_INDICES; i++)
+		{
+			MinMaxNode* node = _tree.nodeTable.GetNodeAtIndex(i);
+			if (node != nullptr && node->GetNodeScore() != solver.GetScore(i))
+				numTreeMismatches++;
+
+			if (SolvedScoreTable::GetScore(i) != solver.GetScore(i))
+				numTableMismatches++;
+		}
+
+		bool sameLayouts = (solver.GetNumPositions() == _tree.GetNumLiveNodes());
+		std::printf("%d threads: %.2f ms, %d positions (tree has %d), %d differ from the tree, %d differ from SolvedScoreTable\n",
+			_numThreads, elapsed.count(), solver.GetNumPositions(), _tree.GetNumLiveNodes(), numTreeMismatches, numTableMismatches);
+
+		return sameLayouts && numTreeMismatches == 0 && numTableMismatches == 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	// Every hardware thread is used for the parallel solve unless a thread count is given on the command line
+	int numThreads = (argc > 1) ? std::atoi(argv[1]) : int(std::thread::hardware_concurrency());
+	numThreads = std::max(2, numThreads);
+
+	// The full node tree, built the original way, is what every other score source has to match
+	MinMaxTree tree;
+	BoardConfiguration emptyLayout = BoardConfiguration();
+	emptyLayout.Init();
+	tree.Init(emptyLayout);
+
+	bool succeeded = CheckSolve(tree, 1);
+	succeeded &= CheckSolve(tree, numThreads);
+
+	std::printf("%s\n", succeeded ? "PASSED" : "FAILED");
+	return succeeded ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+// Plays the engine against itself and against a random opponent with every backend, and reports the results and how long the games last
+// Since wins are scored by how quickly they happen, the engine should never pass up a win on the spot, and self-play should always be a 9 tile tie
+// Build it against the engine source files, as shown under Building The Tools in README.md
+
+#include <cstdio>
+#include <cstdlib>
+#include "../MinMaxTree.h"
+
+namespace
+{
+	const int NUM_SELF_PLAY_GAMES = 20;
+	const int NUM_RANDOM_GAMES = 1000;
+
+	// Results for one set of games, from the engine's perspective
+	struct GameStats
+	{
+		int numGames = 0;
+		int numWins = 0;
+		int numLosses = 0;
+		int numTies = 0;
+		int totalWinLength = 0;
+		int totalLossLength = 0;
+		int totalTieLength = 0;
+		int numMissedWins = 0;
+	};
+
+	// Returns true if the player to move can win by placing one more tile
+	bool HasImmediateWin(const BoardConfiguration& _layout)
+	{
+		char tileToMove = _layout.GetTileToMove();
+		MoveList emptySpaces = _layout.GetEmptySpaces();
+		for (int i = 0; i < emptySpaces.GetSize(); i++)
+		{
+			BoardConfiguration childLayout = _layout;
+			if (childLayout.ApplyMove(emptySpaces[i], tileToMove) == tileToMove)
+				return true;
+		}
+
+		return false;
+	}
+
+	// Lets the engine make a move, counting it as a missed win if it could have won on the spot and didn't
+	BoardConfiguration MakeEngineMove(MinMaxTree& _tree, const BoardConfiguration& _layout, GameStats& _stats)
+	{
+		bool couldWin = HasImmediateWin(_layout);
+		BoardConfiguration newLayout = _tree.DecideNextMove();
+		if (couldWin && newLayout.EvaluateWinner() != _layout.GetTileToMove())
+			_stats.numMissedWins++;
+
+		return newLayout;
+	}
+
+	// Adds a finished game to the stats. The game length is the number of tiles on the board when it ended
+	void RecordGame(GameStats& _stats, const BoardConfiguration& _layout, char _engineTile)
+	{
+		char winner = _layout.EvaluateWinner();
+		int gameLength = _layout.GetNumPlacedTiles();
+		_stats.numGames++;
+
+		if (winner == '-')
+		{
+			_stats.numTies++;
+			_stats.totalTieLength += gameLength;
+		}
+		else if (winner == _engineTile)
+		{
+			_stats.numWins++;
+			_stats.totalWinLength += gameLength;
+		}
+		else
+		{
+			_stats.numLosses++;
+			_stats.totalLossLength += gameLength;
+		}
+	}
+
+	double GetAverage(int _total, int _count)
+	{
+		return (_count > 0) ? double(_total) / double(_count) : 0.0;
+	}
+
+	void PrintStats(const char* _name, const char* _opponent, const GameStats& _stats)
+	{
+		std::printf("%-12s vs %-7s %5d games: %4d wins (avg length %.2f), %4d losses (avg length %.2f), %4d ties (avg length %.2f), %d missed wins\n",
+			_name, _opponent, _stats.numGames,
+			_stats.numWins, GetAverage(_stats.totalWinLength, _stats.numWins),
+			_stats.numLosses, GetAverage(_stats.totalLossLength, _stats.numLosses),
+			_stats.numTies, GetAverage(_stats.totalTieLength, _stats.numTies),
+			_stats.numMissedWins);
+	}
+
+	// Plays both sets of games with one backend, returning false if the engine ever lost, passed up a win or didn't tie itself
+	bool PlayGames(const char* _name, TreeBackend _backend)
+	{
+		MinMaxTree tree;
+		MinMaxTreeSettings settings = MinMaxTreeSettings();
+		settings.backend = _backend;
+		tree.SetSettings(settings);
+
+		BoardConfiguration emptyLayout = BoardConfiguration();
+		emptyLayout.Init();
+		srand(1);
+
+		// Self-play: the engine makes every move for both sides
+		GameStats selfPlayStats = GameStats();
+		for (int game = 0; game < NUM_SELF_PLAY_GAMES; game++)
+		{
+			BoardConfiguration layout = emptyLayout;
+			tree.Init(layout);
+
+			while (layout.EvaluateWinner() == ' ')
+				layout = MakeEngineMove(tree, layout, selfPlayStats);
+
+			RecordGame(selfPlayStats, layout, 'X');
+		}
+
+		// Against a random opponent. The engine alternates between X and O
+		GameStats randomStats = GameStats();
+		for (int game = 0; game < NUM_RANDOM_GAMES; game++)
+		{
+			bool engineIsX = (game % 2 == 0);
+			BoardConfiguration layout = emptyLayout;
+			tree.Init(layout);
+
+			while (layout.EvaluateWinner() == ' ')
+			{
+				if ((layout.GetTileToMove() == 'X') == engineIsX)
+					layout = MakeEngineMove(tree, layout, randomStats);
+				else
+				{
+					MoveList emptySpaces = layout.GetEmptySpaces();
+					BoardLocation move = emptySpaces[rand() % emptySpaces.GetSize()];
+					layout.ApplyMove(move, layout.GetTileToMove());
+					tree.HandlePlayerMove(move);
+				}
+			}
+
+			RecordGame(randomStats, layout, (engineIsX) ? 'X' : 'O');
+		}
+
+		PrintStats(_name, "itself", selfPlayStats);
+		PrintStats(_name, "random", randomStats);
+
+		bool selfPlayTied = selfPlayStats.numTies == selfPlayStats.numGames && selfPlayStats.totalTieLength == selfPlayStats.numGames * BoardLocation::Num_Locations;
+		return selfPlayTied && selfPlayStats.numMissedWins == 0 && randomStats.numLosses == 0 && randomStats.numMissedWins == 0;
+	}
+}
+
+int main()
+{
+	bool succeeded = PlayGames("Node tree", Backend_NodeTree);
+	succeeded &= PlayGames("Solved table", Backend_SolvedTable);
+	succeeded &= PlayGames("Alpha-beta", Backend_AlphaBeta);
+	succeeded &= PlayGames("Graph", Backend_Graph);
+	succeeded &= PlayGames("Retrograde", Backend_Retrograde);
+	succeeded &= PlayGames("Packed table", Backend_PackedTable);
+
+	std::printf("%s\n", succeeded ? "PASSED" : "FAILED");
+	return succeeded ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+// Plays thousands of GameSessions at once on every hardware thread against one shared GameEngine, and reports how many games per second get played
+// Each thread owns a slice of the sessions and plays them a move at a time in turn, the way a server would interleave its players
+// Also builds several separate MinMaxTrees at the same time to check that trees no longer share any state
+// Build it against the engine source files, as shown under Building The Tools in README.md
+// Adding -fsanitize=thread checks that the sessions really don't need any locks
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "../GameEngine.h"
+#include "../MinMaxTree.h"
+
+namespace
+{
+	const int NUM_SESSIONS = 10000;
+	const int GAMES_PER_SESSION = 20;
+	const int NUM_SEPARATE_TREES = 4;
+
+	struct StressResults
+	{
+		int numGames = 0;
+		int numLosses = 0;
+		long long numMoves = 0;
+	};
+
+	// Plays every session whose index is _threadIndex modulo _numThreads, one move per session per pass, until they have all finished their games
+	// The random opponent has its own generator per thread, so nothing is shared between threads except the read-only engine
+	void PlaySessions(std::vector<GameSession>& _sessions, int _threadIndex, int _numThreads, StressResults& _outResults)
+	{
+		std::minstd_rand opponentRandom = std::minstd_rand(uint32_t(_threadIndex + 1));
+		BoardConfiguration emptyLayout = BoardConfiguration();
+		emptyLayout.Init();
+
+		std::vector<int> gamesLeft = std::vector<int>();
+		for (int i = _threadIndex; i < int(_sessions.size()); i += _numThreads)
+		{
+			_sessions[i].Init(emptyLayout);
+			gamesLeft.push_back(GAMES_PER_SESSION);
+		}
+
+		int numActive = int(gamesLeft.size());
+		while (numActive > 0)
+		{
+			for (int slot = 0; slot < int(gamesLeft.size()); slot++)
+			{
+				if (gamesLeft[slot] == 0)
+					continue;
+
+				// The engine plays X in even sessions and O in odd ones
+				int sessionIndex = _threadIndex + slot * _numThreads;
+				GameSession& session = _sessions[sessionIndex];
+				char engineTile = (sessionIndex % 2 == 0) ? 'X' : 'O';
+				const BoardConfiguration& layout = session.GetLayout();
+
+				if (layout.GetTileToMove() == engineTile)
+					session.DecideNextMove();
+				else
+				{
+					MoveList emptySpaces = layout.GetEmptySpaces();
+					session.HandlePlayerMove(emptySpaces[opponentRandom() % emptySpaces.GetSize()]);
+				}
+				_outResults.numMoves++;
+
+				// Start the next game once this one is over
+				char winner = session.GetLayout().EvaluateWinner();
+				if (winner != ' ')
+				{
+					_outResults.numGames++;
+					if (winner != '-' && winner != engineTile)
+						_outResults.numLosses++;
+
+					session.Init(emptyLayout);
+					if (--gamesLeft[slot] == 0)
+						numActive--;
+				}
+			}
+		}
+	}
+
+	// Plays every session's games on the given number of threads and returns false if the engine ever lost
+	bool RunSessions(const GameEngine& _engine, int _numThreads)
+	{
+		std::vector<GameSession> sessions = std::vector<GameSession>();
+		for (int i = 0; i < NUM_SESSIONS; i++)
+			sessions.push_back(GameSession(&_engine, uint32_t(i + 1)));
+
+		std::vector<StressResults> results = std::vector<StressResults>(_numThreads);
+		std::vector<std::thread> threads = std::vector<std::thread>();
+		auto startTime = std::chrono::steady_clock::now();
+		for (int i = 0; i < _numThreads; i++)
+			threads.push_back(std::thread(PlaySessions, std::ref(sessions), i, _numThreads, std::ref(results[i])));
+
+		for (int i = 0; i < _numThreads; i++)
+			threads[i].join();
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+		StressResults total = StressResults();
+		for (int i = 0; i < _numThreads; i++)
+		{
+			total.numGames += results[i].numGames;
+			total.numLosses += results[i].numLosses;
+			total.numMoves += results[i].numMoves;
+		}
+
+		std::printf("%2d threads, %d sessions (%d bytes each): %d games, %lld moves in %.3f s = %.0f games/s, %d losses\n",
+			_numThreads, NUM_SESSIONS, int(sizeof(GameSession)), total.numGames, total.numMoves, elapsed.count(), total.numGames / elapsed.count(), total.numLosses);
+
+		return total.numLosses == 0 && total.numGames == NUM_SESSIONS * GAMES_PER_SESSION;
+	}
+
+	// Builds one full node tree per thread, all at the same time, and checks each of them against the compile-time solution
+	bool BuildSeparateTrees()
+	{
+		std::vector<int> numMismatches = std::vector<int>(NUM_SEPARATE_TREES, -1);
+		std::vector<std::thread> threads = std::vector<std::thread>();
+		for (int i = 0; i < NUM_SEPARATE_TREES; i++)
+		{
+			threads.push_back(std::thread([&numMismatches, i]()
+			{
+				MinMaxTree tree;
+				BoardConfiguration emptyLayout = BoardConfiguration();
+				emptyLayout.Init();
+				tree.SetSeed(uint32_t(i + 1));
+				tree.Init(emptyLayout);
+				numMismatches[i] = tree.CompareWithSolvedTable();
+			}));
+		}
+
+		bool succeeded = true;
+		for (int i = 0; i < NUM_SEPARATE_TREES; i++)
+		{
+			threads[i].join();
+			succeeded &= (numMismatches[i] == 0);
+		}
+
+		std::printf("%d trees built at once: %s\n", NUM_SEPARATE_TREES, succeeded ? "all match the solved table" : "MISMATCHES");
+		return succeeded;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	// Every hardware thread is used unless a thread count is given on the command line
+	int numThreads = (argc > 1) ? std::atoi(argv[1]) : int(std::thread::hardware_concurrency());
+	numThreads = std::max(1, numThreads);
+
+	// Solve once, then every session on every thread shares the same read-only engine
+	GameEngine engine;
+	engine.Init(EngineSource_Retrograde, numThreads);
+
+	bool succeeded = RunSessions(engine, 1);
+	succeeded &= RunSessions(engine, numThreads);
+	succeeded &= BuildSeparateTrees();
+
+	std::printf("%s\n", succeeded ? "PASSED" : "FAILED");
+	return succeeded ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+// Measures how many probes and stores per second TranspositionTable can handle as threads are added,
+// compared to a std::unordered_map behind a std::mutex doing the same work
+// Build it against the engine source files, as shown under Building The Tools in README.md
+// Pass the highest thread count to test on the command line to override the number of hardware threads
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "../TranspositionTable.h"
+
+namespace
+{
+	const int TABLE_CAPACITY = 1 << 20;
+	const int NUM_KEYS = 1 << 19;
+	const int OPERATIONS_PER_THREAD = 4000000;
+
+	// 1 in this many operations is a store and the rest are probes, which is roughly what a search does
+	const int STORE_FREQUENCY = 4;
+
+	uint64_t MakeHash(uint64_t _key)
+	{
+		uint64_t hash = _key + 0x9E3779B97F4A7C15ull;
+		hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+		hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+		return hash ^ (hash >> 31);
+	}
+
+	// The baseline: the same operations on a standard map with one lock around it
+	class LockedTable
+	{
+	public:
+		bool Probe(uint64_t _hash, TranspositionEntry& _outEntry)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto found = entries.find(_hash);
+			if (found == entries.end())
+				return false;
+
+			_outEntry = found->second;
+			return true;
+		}
+
+		void Store(uint64_t _hash, const TranspositionEntry& _entry)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			entries[_hash] = _entry;
+		}
+
+	private:
+		std::mutex mutex;
+		std::unordered_map<uint64_t, TranspositionEntry> entries;
+	};
+
+	// Runs the same random mix of probes and stores on every thread and returns the total operations per second
+	template<typename Table>
+	double MeasureThroughput(Table& _table, int _numThreads)
+	{
+		std::vector<std::thread> threads = std::vector<std::thread>();
+		std::vector<int> numHits = std::vector<int>(_numThreads, 0);
+		auto startTime = std::chrono::steady_clock::now();
+		for (int i = 0; i < _numThreads; i++)
+		{
+			threads.push_back(std::thread([&_table, &numHits, i]()
+			{
+				std::minstd_rand random = std::minstd_rand(uint32_t(i + 1));
+				TranspositionEntry storedEntry = { 1, Bound_Exact, 4, 9 };
+				int threadHits = 0;
+				for (int op = 0; op < OPERATIONS_PER_THREAD; op++)
+				{
+					uint64_t hash = MakeHash(random() % NUM_KEYS);
+					if (op % STORE_FREQUENCY == 0)
+						_table.Store(hash, storedEntry);
+					else
+					{
+						TranspositionEntry entry;
+						threadHits += _table.Probe(hash, entry) ? 1 : 0;
+					}
+				}
+
+				// Only written once at the end so the threads don't fight over the cache line
+				numHits[i] = threadHits;
+			}));
+		}
+
+		for (int i = 0; i < _numThreads; i++)
+			threads[i].join();
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+		return double(_numThreads) * OPERATIONS_PER_THREAD / elapsed.count();
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int maxThreads = (argc > 1) ? std::atoi(argv[1]) : int(std::thread::hardware_concurrency());
+	maxThreads = std::max(1, maxThreads);
+
+	std::printf("%d operations per thread, 1 in %d is a store, %d keys\n", OPERATIONS_PER_THREAD, STORE_FREQUENCY, NUM_KEYS);
+	for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+	{
+		TranspositionTable lockFreeTable = TranspositionTable(TABLE_CAPACITY);
+		LockedTable lockedTable;
+		double lockFreeRate = MeasureThroughput(lockFreeTable, numThreads);
+		double lockedRate = MeasureThroughput(lockedTable, numThreads);
+
+		std::printf("%2d threads: lock free %8.1f M ops/s   mutex + unordered_map %8.1f M ops/s   (%.1fx)\n",
+			numThreads, lockFreeRate / 1e6, lockedRate / 1e6, lockFreeRate / lockedRate);
+
+		// Always finish on the highest thread count, even if it isn't a power of two
+		if (numThreads < maxThreads && numThreads * 2 > maxThreads)
+			numThreads = maxThreads / 2;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+// Hammers one TranspositionTable from many threads at once and fails if a probe ever returns an entry that wasn't stored for that hash
+// The first test stores and probes made up entries in a table that is far too small, so slots are constantly fought over and replaced
+// The second test runs a full alpha-beta search of every position on every thread, all sharing one table, and checks every score against SolvedScoreTable
+// Build it against the engine source files, as shown under Building The Tools in README.md
+// Pass a thread count on the command line to override the number of hardware threads. Adding -fsanitize=thread checks that no locks are needed
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../AlphaBetaSearch.h"
+#include "../SolvedScoreTable.h"
+#include "../TranspositionTable.h"
+
+namespace
+{
+	const int NUM_KEYS = 4096;
+	const int SMALL_TABLE_CAPACITY = 1024;
+	const int OPERATIONS_PER_THREAD = 2000000;
+
+	// The same splitmix64 finalizer as BoardConfiguration::GetHash(), used here to make up hashes for keys that aren't real layouts
+	uint64_t MakeHash(uint64_t _key)
+	{
+		uint64_t hash = _key + 0x9E3779B97F4A7C15ull;
+		hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+		hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+		return hash ^ (hash >> 31);
+	}
+
+	// Every field except the depth comes from the key, so a probe can tell if it got back something that was stored for a different key
+	TranspositionEntry MakeEntry(int _key, int _depth)
+	{
+		TranspositionEntry entry;
+		entry.score = int8_t(_key % 11 - 5);
+		entry.bound = uint8_t(Bound_Exact + _key % 3);
+		entry.bestMove = uint8_t(_key % BoardLocation::Num_Locations);
+		entry.depth = uint8_t(_depth);
+		return entry;
+	}
+
+	bool MatchesKey(const TranspositionEntry& _entry, int _key)
+	{
+		TranspositionEntry expected = MakeEntry(_key, 0);
+		return _entry.score == expected.score && _entry.bound == expected.bound && _entry.bestMove == expected.bestMove;
+	}
+
+	// Half of the operations store and half probe, all on random keys
+	bool StressStoreAndProbe(int _numThreads)
+	{
+		TranspositionTable table = TranspositionTable(SMALL_TABLE_CAPACITY);
+		std::atomic<long long> numHits = std::atomic<long long>(0);
+		std::atomic<long long> numBadEntries = std::atomic<long long>(0);
+
+		std::vector<std::thread> threads = std::vector<std::thread>();
+		for (int i = 0; i < _numThreads; i++)
+		{
+			threads.push_back(std::thread([&table, &numHits, &numBadEntries, i]()
+			{
+				std::minstd_rand random = std::minstd_rand(uint32_t(i + 1));
+				long long threadHits = 0;
+				long long threadBadEntries = 0;
+				for (int op = 0; op < OPERATIONS_PER_THREAD; op++)
+				{
+					int key = int(random() % NUM_KEYS);
+					if (random() % 2 == 0)
+						table.Store(MakeHash(key), MakeEntry(key, int(random() % 10)));
+					else
+					{
+						TranspositionEntry entry;
+						if (table.Probe(MakeHash(key), entry))
+						{
+							threadHits++;
+							if (!MatchesKey(entry, key))
+								threadBadEntries++;
+						}
+					}
+				}
+
+				numHits += threadHits;
+				numBadEntries += threadBadEntries;
+			}));
+		}
+
+		for (int i = 0; i < _numThreads; i++)
+			threads[i].join();
+
+		std::printf("Store and probe: %d threads, %d operations each, %lld hits, %lld bad entries\n", _numThreads, OPERATIONS_PER_THREAD, numHits.load(), numBadEntries.load());
+		return numBadEntries == 0 && numHits > 0;
+	}
+
+	// Lists every layout that is still being played, by walking the game from the empty board
+	std::vector<BoardConfiguration> ListUnfinishedLayouts()
+	{
+		std::vector<bool> isListed = std::vector<bool>(NUM_BOARD_INDICES, false);
+		std::vector<BoardConfiguration> layouts = std::vector<BoardConfiguration>();
+		BoardConfiguration emptyLayout = BoardConfiguration();
+		emptyLayout.Init();
+		layouts.push_back(emptyLayout);
+		isListed[emptyLayout.GetIndex()] = true;
+
+		for (int i = 0; i < int(layouts.size()); i++)
+		{
+			MoveList emptySpaces = layouts[i].GetEmptySpaces();
+			for (int j = 0; j < emptySpaces.GetSize(); j++)
+			{
+				BoardConfiguration childLayout = layouts[i];
+				childLayout.ApplyMove(emptySpaces[j], layouts[i].GetTileToMove());
+				if (childLayout.EvaluateWinner() == ' ' && !isListed[childLayout.GetIndex()])
+				{
+					isListed[childLayout.GetIndex()] = true;
+					layouts.push_back(childLayout);
+				}
+			}
+		}
+
+		return layouts;
+	}
+
+	// Every thread searches every unfinished layout in its own random order, so the threads are constantly reading each other's entries
+	bool StressSharedSearch(int _numThreads)
+	{
+		TranspositionTable table;
+		std::vector<BoardConfiguration> layouts = ListUnfinishedLayouts();
+		std::atomic<int> numWrongScores = std::atomic<int>(0);
+
+		std::vector<std::thread> threads = std::vector<std::thread>();
+		for (int i = 0; i < _numThreads; i++)
+		{
+			threads.push_back(std::thread([&table, &layouts, &numWrongScores, i]()
+			{
+				std::vector<BoardConfiguration> order = layouts;
+				std::shuffle(order.begin(), order.end(), std::minstd_rand(uint32_t(i + 1)));
+
+				AlphaBetaSearch search;
+				search.SetSeed(uint32_t(i + 1));
+				search.SetSharedTable(&table);
+				for (int j = 0; j < int(order.size()); j++)
+				{
+					// Scores in the search are from the mover's perspective, and the table's are from X's
+					int score = 0;
+					BoardLocation move = search.FindBestMove(order[j], &score);
+					int sign = (order[j].GetTileToMove() == 'X') ? 1 : -1;
+					BoardConfiguration childLayout = order[j];
+					childLayout.ApplyMove(move, order[j].GetTileToMove());
+
+					if (score * sign != SolvedScoreTable::GetScore(order[j]) || SolvedScoreTable::GetScore(childLayout) != SolvedScoreTable::GetScore(order[j]))
+						numWrongScores++;
+				}
+			}));
+		}
+
+		for (int i = 0; i < _numThreads; i++)
+			threads[i].join();
+
+		std::printf("Shared search: %d threads, %d layouts each, %d slots used, %d wrong scores\n", _numThreads, int(layouts.size()), table.GetNumUsedSlots(), numWrongScores.load());
+		return numWrongScores == 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	// At least a few threads are used even on a single core, so the threads still interleave
+	int numThreads = (argc > 1) ? std::atoi(argv[1]) : std::max(4, int(std::thread::hardware_concurrency()));
+	numThreads = std::max(1, numThreads);
+
+	bool succeeded = StressStoreAndProbe(numThreads);
+	succeeded &= StressSharedSearch(numThreads);
+
+	std::printf("%s\n", succeeded ? "PASSED" : "FAILED");
+	return succeeded ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "TranspositionTable.h"
+
+
+
+//--- Constructors and Destructor ---//
+TranspositionTable::TranspositionTable(int _capacity)
+{
+	// Round the capacity up to a power of two so a slot can be picked from the hash with a mask instead of a division
+	capacity = 1;
+	while (capacity < _capacity)
+		capacity *= 2;
+
+	slotMask = uint64_t(capacity - 1);
+	slots = std::unique_ptr<Slot[]>(new Slot[capacity]);
+	Clear();
+}
+
+TranspositionTable::~TranspositionTable()
+{
+}
+
+
+
+//--- Methods ---//
+bool TranspositionTable::Probe(uint64_t _hash, TranspositionEntry& _outEntry) const
+{
+	// Look through the slots the hash could have been stored in. The two words are read separately, so they only count as a hit
+	// if they XOR back to the hash, which means they came from the same write of this position
+	for (int i = 0; i < MAX_PROBES; i++)
+	{
+		const Slot& slot = slots[(_hash + i) & slotMask];
+		uint64_t data = slot.data.load(std::memory_order_relaxed);
+		uint64_t check = slot.check.load(std::memory_order_relaxed);
+
+		if (data != 0 && (check ^ data) == _hash)
+		{
+			_outEntry = UnpackEntry(data);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void TranspositionTable::Store(uint64_t _hash, const TranspositionEntry& _entry)
+{
+	// Use the slot that already holds this position, or the first empty one. If every slot is taken by something else,
+	// replace the one that was searched the least deeply since it is the cheapest to find again
+	Slot* targetSlot = nullptr;
+	int lowestDepth = 0;
+	for (int i = 0; i < MAX_PROBES; i++)
+	{
+		Slot& slot = slots[(_hash + i) & slotMask];
+		uint64_t data = slot.data.load(std::memory_order_relaxed);
+		uint64_t check = slot.check.load(std::memory_order_relaxed);
+
+		if (data == 0 || (check ^ data) == _hash)
+		{
+			targetSlot = &slot;
+			break;
+		}
+
+		int depth = UnpackEntry(data).depth;
+		if (targetSlot == nullptr || depth < lowestDepth)
+		{
+			targetSlot = &slot;
+			lowestDepth = depth;
+		}
+	}
+
+	// Another thread can write the same slot at the same time. That only tears the slot, which Probe() treats as empty
+	uint64_t data = PackEntry(_entry);
+	targetSlot->data.store(data, std::memory_order_relaxed);
+	targetSlot->check.store(_hash ^ data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::Clear()
+{
+	// Only safe while no search is using the table
+	for (int i = 0; i < capacity; i++)
+	{
+		slots[i].data.store(0, std::memory_order_relaxed);
+		slots[i].check.store(0, std::memory_order_relaxed);
+	}
+}
+
+
+
+//--- Setters and Getters ---//
+int TranspositionTable::GetCapacity() const {
+	return capacity;
+}
+
+int TranspositionTable::GetNumUsedSlots() const
+{
+	int numUsedSlots = 0;
+	for (int i = 0; i < capacity; i++)
+	{
+		if (slots[i].data.load(std::memory_order_relaxed) != 0)
+			numUsedSlots++;
+	}
+
+	return numUsedSlots;
+}
+
+
+
+//--- Utility Functions ---//
+uint64_t TranspositionTable::PackEntry(const TranspositionEntry& _entry)
+{
+	// One byte per field. A stored entry always has a bound, so it never packs to 0 and can't be mistaken for an empty slot
+	return uint64_t(uint8_t(_entry.score)) | (uint64_t(_entry.bound) << 8) | (uint64_t(_entry.bestMove) << 16) | (uint64_t(_entry.depth) << 24);
+}
+
+TranspositionEntry TranspositionTable::UnpackEntry(uint64_t _data)
+{
+	TranspositionEntry entry;
+	entry.score = int8_t(uint8_t(_data));
+	entry.bound = uint8_t(_data >> 8);
+	entry.bestMove = uint8_t(_data >> 16);
+	entry.depth = uint8_t(_data >> 24);
+	return entry;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// What a transposition table score means, since alpha-beta cutoffs only prove a bound on some scores
+enum ScoreBound
+{
+	Bound_None,		// Empty entry
+	Bound_Exact,
+	Bound_Lower,	// The real score is at least this (the search failed high)
+	Bound_Upper		// The real score is at most this (the search failed low)
+};
+
+struct TranspositionEntry
+{
+	int8_t score;
+	uint8_t bound;
+	uint8_t bestMove;
+	uint8_t depth;	// How many moves ahead the score was searched. Num_Locations means it was searched all the way to the end
+};
+
+// A fixed-size transposition table that any number of searches can probe and store into at the same time without locks
+// Entries are found by a 64-bit position hash (BoardConfiguration::GetHash()) with open addressing over a few neighbouring slots
+// Each slot is two atomic words: the packed entry and the hash XORed with it. A slot that two threads wrote at once ends up with
+// words from different writes, which no longer XOR back to the hash, so a torn slot just reads as a miss instead of a wrong score
+class TranspositionTable
+{
+public:
+	//--- Constructors and Destructor ---//
+	TranspositionTable(int _capacity = DEFAULT_CAPACITY);
+	~TranspositionTable();
+
+	//--- Methods ---//
+	bool Probe(uint64_t _hash, TranspositionEntry& _outEntry) const;
+	void Store(uint64_t _hash, const TranspositionEntry& _entry);
+	void Clear();
+
+	//--- Setters and Getters ---//
+	int GetCapacity() const;
+	int GetNumUsedSlots() const;
+
+	//--- Static Variables ---//
+	// Every reachable layout fits several times over, so the probe sequences stay short
+	static const int DEFAULT_CAPACITY = 1 << 15;
+
+	// How many slots after the hash's home slot an entry can be stored in
+	static const int MAX_PROBES = 4;
+
+private:
+	//--- Data ---//
+	struct Slot
+	{
+		std::atomic<uint64_t> check;	// The hash XORed with data, 0 when empty
+		std::atomic<uint64_t> data;		// The packed TranspositionEntry, 0 when empty
+	};
+
+	std::unique_ptr<Slot[]> slots;
+	int capacity;
+	uint64_t slotMask;
+
+	//--- Utility Functions ---//
+	static uint64_t PackEntry(const TranspositionEntry& _entry);
+	static TranspositionEntry UnpackEntry(uint64_t _data);
+};
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "WorkStealingPool.h"
+
+namespace
+{
+	// Which pool and worker the current thread belongs to, so tasks submitted from a worker stay on that worker's queue
+	thread_local WorkStealingPool* currentPool = nullptr;
+	thread_local int currentWorker = -1;
+}
+
+
+
+//--- Constructors and Destructor ---//
+WorkStealingPool::WorkStealingPool(int _numThreads)
+{
+	numQueuedTasks = 0;
+	numPendingTasks = 0;
+	numSteals = 0;
+	nextQueue = 0;
+	isShuttingDown = false;
+
+	// Always have at least one worker
+	if (_numThreads < 1)
+		_numThreads = 1;
+
+	// Create all of the queues before starting any threads since the workers steal from each other's queues
+	for (int i = 0; i < _numThreads; i++)
+		queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+
+	for (int i = 0; i < _numThreads; i++)
+		threads.push_back(std::thread(&WorkStealingPool::WorkerLoop, this, i));
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+	// Wake up every worker and wait for them to exit
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		isShuttingDown = true;
+	}
+	workAvailable.notify_all();
+
+	for (int i = 0; i < threads.size(); i++)
+		threads[i].join();
+}
+
+
+
+//--- Methods ---//
+void WorkStealingPool::Submit(std::function<void(int)> _task)
+{
+	// Tasks submitted by a worker go to the back of its own queue. Tasks from outside the pool are spread across the queues
+	int queueIndex = (currentPool == this) ? currentWorker : (nextQueue++ % int(queues.size()));
+
+	numPendingTasks++;
+	{
+		std::lock_guard<std::mutex> lock(queues[queueIndex]->mutex);
+		queues[queueIndex]->tasks.push_back(std::move(_task));
+	}
+
+	// Count the task as queued before waking anyone up so a worker that is about to sleep sees it
+	numQueuedTasks++;
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+	workAvailable.notify_one();
+}
+
+void WorkStealingPool::WaitForAll()
+{
+	// Block until every submitted task, including the ones submitted by other tasks, has finished
+	std::unique_lock<std::mutex> lock(sleepMutex);
+	allTasksDone.wait(lock, [this]() { return numPendingTasks == 0; });
+}
+
+
+
+//--- Setters and Getters ---//
+int WorkStealingPool::GetNumThreads() const {
+	return int(threads.size());
+}
+
+int WorkStealingPool::GetNumSteals() const {
+	return numSteals;
+}
+
+
+
+//--- Utility Functions ---//
+void WorkStealingPool::WorkerLoop(int _workerIndex)
+{
+	currentPool = this;
+	currentWorker = _workerIndex;
+
+	while (true)
+	{
+		// Keep running tasks for as long as there are any
+		if (TryRunTask(_workerIndex))
+			continue;
+
+		// Otherwise, sleep until something is submitted or the pool is shut down
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		workAvailable.wait(lock, [this]() { return isShuttingDown || numQueuedTasks > 0; });
+
+		if (isShuttingDown)
+			return;
+	}
+}
+
+bool WorkStealingPool::TryRunTask(int _workerIndex)
+{
+	std::function<void(int)> task;
+	bool foundTask = false;
+
+	// Take the newest task from our own queue first since it is the most likely to still be in the cache
+	{
+		WorkerQueue& ownQueue = *queues[_workerIndex];
+		std::lock_guard<std::mutex> lock(ownQueue.mutex);
+		if (!ownQueue.tasks.empty())
+		{
+			task = std::move(ownQueue.tasks.back());
+			ownQueue.tasks.pop_back();
+			foundTask = true;
+		}
+	}
+
+	// If our queue is empty, steal the oldest task from someone else. Older tasks are usually bigger subtrees
+	for (int i = 1; !foundTask && i < queues.size(); i++)
+	{
+		WorkerQueue& otherQueue = *queues[(_workerIndex + i) % queues.size()];
+		std::lock_guard<std::mutex> lock(otherQueue.mutex);
+		if (!otherQueue.tasks.empty())
+		{
+			task = std::move(otherQueue.tasks.front());
+			otherQueue.tasks.pop_front();
+			foundTask = true;
+			numSteals++;
+		}
+	}
+
+	if (!foundTask)
+		return false;
+
+	numQueuedTasks--;
+	task(_workerIndex);
+
+	// Let WaitForAll know once the last task is done
+	if (--numPendingTasks == 0)
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		allTasksDone.notify_all();
+	}
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of worker threads that each have their own queue of tasks
+// Tasks submitted from a worker go onto that worker's queue, and idle workers steal from the other end of everyone else's queue
+// Every task is given the index of the worker running it so it can use per-worker data without locking
+class WorkStealingPool
+{
+public:
+	//--- Constructors and Destructor ---//
+	WorkStealingPool(int _numThreads);
+	~WorkStealingPool();
+
+	//--- Methods ---//
+	void Submit(std::function<void(int)> _task);
+	void WaitForAll();
+
+	//--- Setters and Getters ---//
+	int GetNumThreads() const;
+	int GetNumSteals() const;
+
+private:
+	//--- Data ---//
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<std::function<void(int)>> tasks;
+	};
+
+	std::vector<std::unique_ptr<WorkerQueue>> queues;
+	std::vector<std::thread> threads;
+
+	// Tasks that are sitting in a queue, and tasks that have been submitted but haven't finished yet
+	std::atomic<int> numQueuedTasks;
+	std::atomic<int> numPendingTasks;
+	std::atomic<int> numSteals;
+	std::atomic<int> nextQueue;
+	std::atomic<bool> isShuttingDown;
+
+	// Idle workers sleep on workAvailable, and WaitForAll sleeps on allTasksDone
+	std::mutex sleepMutex;
+	std::condition_variable workAvailable;
+	std::condition_variable allTasksDone;
+
+	//--- Utility Functions ---//
+	void WorkerLoop(int _workerIndex);
+	bool TryRunTask(int _workerIndex);
+};
\ No newline at end of file
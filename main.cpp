@@ -30,12 +30,62 @@ int playerTileChoice; //0 = X, 1 = O
 glm::vec2 mousePos;
 bool playerFirstMove = true;
 
+void MakeAIMove()
+{
+	// Let the AI pick its move and show it on the board
+	board.HandleAIMove(tree.DecideNextMove());
+
+	// The alpha-beta backend searches on every move, so output stats about the search it just did
+	if (tree.GetSettings().backend == Backend_AlphaBeta)
+	{
+		const AlphaBetaSearch& search = tree.GetAlphaBetaSearch();
+		std::cout << "Nodes Searched: " << search.GetNodesSearched() << std::endl;
+		std::cout << "Table Hits: " << search.GetTableHits() << std::endl;
+		std::cout << "Cutoffs: " << search.GetCutoffs() << std::endl;
+		std::cout << "Depth Reached: " << search.GetDepthReached() << std::endl;
+	}
+
+	// The node tree grows as the game goes when it is lazy, and shrinks when unreachable nodes are reclaimed, so output how many nodes it has now
+	if (tree.GetSettings().backend == Backend_NodeTree && (tree.GetSettings().expandLazily || tree.GetSettings().reclaimUnreachable))
+		std::cout << "Node List Size: " << tree.GetNumLiveNodes() << std::endl;
+}
+
+void ReportTreeBuild()
+{
+	// The graph is only built for the first game, so output stats about it when it was just built
+	if (tree.GetSettings().backend == Backend_Graph && tree.GetLastBuildTime() > 0.0)
+	{
+		const GameGraph& graph = tree.GetGameGraph();
+		std::cout << "Graph built in " << tree.GetLastBuildTime() << " ms" << std::endl;
+		std::cout << "Graph Nodes: " << graph.GetNumNodes() << ", Edges: " << graph.GetNumEdges() << ", Memory: " << graph.GetBytesUsed() << " bytes" << std::endl;
+	}
+
+	// The retrograde solve also only happens for the first game
+	if (tree.GetSettings().backend == Backend_Retrograde && tree.GetLastBuildTime() > 0.0)
+		std::cout << "Retrograde solve: " << tree.GetLastBuildTime() << " ms" << std::endl;
+
+	// The packed table is made the first time it is needed too, and its size is the reason to use it
+	if (tree.GetSettings().backend == Backend_PackedTable && tree.GetLastBuildTime() > 0.0)
+		std::cout << "Packed Table Memory: " << tree.GetPackedScoreTable().GetBytesUsed() << " bytes" << std::endl;
+
+	// Same for a node tree built on several threads, along with how well the work was spread between them
+	const MinMaxTreeSettings& settings = tree.GetSettings();
+	if (settings.backend == Backend_NodeTree && settings.numBuildThreads > 1 && !settings.expandLazily && tree.GetLastBuildTime() > 0.0)
+	{
+		std::cout << "Build Threads: " << settings.numBuildThreads << std::endl;
+		std::cout << "Tasks Stolen: " << tree.GetNumTasksStolen() << std::endl;
+	}
+}
+
 
 void OnMouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
 {
 	// When the left mouse is pressed, we need to tell the board to handle it and maybe place a tile
 	if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS)
 	{
+		// Remember which tile was clicked since placing it clears the hover
+		BoardLocation clickedTile = board.GetHoveredTile();
+
 		// Try to place a tile on the board. Returns true if the tile placement succeeded
 		if (board.HandleMouseClick())
 		{
@@ -43,10 +93,11 @@ void OnMouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
 			if (playerFirstMove)
 			{
 				// Init the AI tree now that the player has placed the first tile. Use the board's configuration as the root node
-				tree.Init(false, board.GetCurrentLayout());
+				tree.Init(board.GetCurrentLayout());
+				ReportTreeBuild();
 
 				// Now, the AI needs to respond
-				board.HandleAIMove(tree.DecideNextMove());
+				MakeAIMove();
 
 				// No longer the first move
 				playerFirstMove = false;
@@ -57,10 +108,11 @@ void OnMouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
 				if (!board.GetIsGameOver())
 				{
 					// We need to transition to the next tree node based on the player's choice
-					tree.HandlePlayerMove(board.GetCurrentLayout());
-
-					// Now, the AI needs to respond
-					board.HandleAIMove(tree.DecideNextMove());
+					// Then the AI needs to respond, but only if the tree took the move. Otherwise it is out of sync with the board and would answer the wrong layout
+					if (tree.HandlePlayerMove(clickedTile))
+						MakeAIMove();
+					else
+						std::cout << "The AI rejected the move, so it is out of sync with the board" << std::endl;
 				}
 			}
 		}
@@ -79,6 +131,12 @@ void Initialize()
 	// Init the TicTacToe Game
 	renderer.Init();
 	board.Init();
+
+	// Have the AI use the table that was solved at compile time so the first move doesn't stall while a tree is built
+	// Switch this back to Backend_NodeTree to use the runtime tree instead
+	MinMaxTreeSettings treeSettings = MinMaxTreeSettings();
+	treeSettings.backend = Backend_SolvedTable;
+	tree.SetSettings(treeSettings);
 }
 
 float Lerp(float _a, float _b, float _t) {
@@ -168,17 +226,19 @@ void GUI()
 				blankLayout.Init();
 
 				// Set up the AI tree now
-				tree.Init(true, blankLayout);
+				tree.Init(blankLayout);
+				ReportTreeBuild();
 
 				//// Set up the AI tree with a test layout
 				//BoardConfiguration testLayout = BoardConfiguration();
-				//testLayout.placedTiles[0] = 'X'; testLayout.placedTiles[1] = 'O'; testLayout.placedTiles[2] = 'O';
-				//testLayout.placedTiles[3] = '-'; testLayout.placedTiles[4] = 'X'; testLayout.placedTiles[5] = '-';
-				//testLayout.placedTiles[6] = '-'; testLayout.placedTiles[7] = 'X'; testLayout.placedTiles[8] = 'O';
-				//tree.Init(true, testLayout, true);
+				//testLayout.Init();
+				//testLayout.SetTile(Top_Left, 'X'); testLayout.SetTile(Top_Middle, 'O'); testLayout.SetTile(Top_Right, 'O');
+				//testLayout.SetTile(Center_Middle, 'X');
+				//testLayout.SetTile(Bottom_Middle, 'X'); testLayout.SetTile(Bottom_Right, 'O');
+				//tree.Init(testLayout);
 
 				// Make a decision to start the game
-				board.HandleAIMove(tree.DecideNextMove());
+				MakeAIMove();
 			}
 		}
     }